@@ -0,0 +1,103 @@
+/*
+ * Model of blobFromImage_int8 against the float blobFromImage_api ops
+ *
+ * For every op and every uint8 input, the fixed point map of
+ * blobQuantParams as the int8 kernel computes it (48-bit accumulator, srs
+ * with floor rounding, clamp to [lo, hi]) is compared with the float op
+ * quantized to int8 (round half up, then clip and int8 saturation). The
+ * int16 srs saturates (set_sat), the last case leaves int16 range. scale
+ * and bias are rounded to 2^-shift, so inputs within tieWindow() of a tie
+ * may round either way, every other sample has to match exactly.
+ *
+ * Usage: blob_model (returns 0 if every sample matches)
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "blob_params.hpp"
+
+namespace {
+
+struct FloatParams {
+    float alpha, beta, gama;
+    int threshold1, threshold2;
+    float out_scale;
+};
+
+// blobFromImage_api in float, as the v8float kernel computes it
+float floatOp(int op, float x, const FloatParams& p) {
+    float y = x;
+    switch (op) {
+        case BLOB_MEAN_SUB:
+            y = x - p.alpha;
+            break;
+        case BLOB_SCALE_N_CLIP:
+            y = x * p.beta;
+            break;
+        case BLOB_SCALE_N_BIAS:
+            y = x * p.beta + p.gama;
+            break;
+        case BLOB_SCALE_N_BIAS_MEAN_SUB:
+        case BLOB_FUSED_OP:
+            y = (x - p.alpha) * p.beta + p.gama;
+            break;
+        default:
+            break;
+    }
+    if (op == BLOB_SCALE_N_CLIP || op == BLOB_CLIP || op == BLOB_FUSED_OP) {
+        y = std::min(std::max(y, (float)p.threshold1), (float)p.threshold2);
+    }
+    return y;
+}
+
+// scale and bias are rounded to half an LSB of 2^-shift each, over x < 256
+// that is at most 128 LSB, plus the float error of the reference
+double tieWindow(const BlobQuantParams& q) {
+    return std::ldexp(128.0, -q.shift) + 1e-4;
+}
+
+int int8Kernel(int x, const BlobQuantParams& q) {
+    const int64_t acc = (int64_t)x * q.scale + q.bias;
+    int64_t y = acc >> q.shift;
+    y = std::min<int64_t>(std::max<int64_t>(y, INT16_MIN), INT16_MAX);
+    return (int)std::min<int64_t>(std::max<int64_t>(y, q.lo), q.hi);
+}
+
+} // namespace
+
+int main() {
+    const FloatParams cases[] = {{0.342f, 1 / 255.f, 5.2432f, -2, 3, 0.05f},
+                                 {127.5f, 1 / 127.5f, 0.0f, -1, 1, 1 / 127.f},
+                                 {103.94f, 0.017f, 0.0f, -2, 2, 0.02f},
+                                 {0.0f, 1.0f, -128.0f, -128, 127, 1.0f},
+                                 {200.0f, 1.0f, 0.0f, -128, 127, 0.005f}}; // beyond int16 before the clamp
+
+    int failed = 0;
+    for (const auto& p : cases) {
+        for (int op = BLOB_MEAN_SUB; op <= BLOB_FUSED_OP; op++) {
+            const BlobQuantParams q =
+                blobQuantParams(op, p.alpha, p.beta, p.gama, p.threshold1, p.threshold2, p.out_scale);
+            auto quantize = [](double r) { return (int)std::min(std::max(r, (double)INT8_MIN), (double)INT8_MAX); };
+            const double window = tieWindow(q);
+            int mismatches = 0;
+            int ties = 0;
+            for (int x = 0; x < 256; x++) {
+                const double v = floatOp(op, (float)x, p) / p.out_scale;
+                const int k = int8Kernel(x, q);
+                const bool tie = std::fabs(v - std::floor(v) - 0.5) < window;
+                ties += tie;
+                const bool neighbour = (k == quantize(std::floor(v))) || (k == quantize(std::floor(v) + 1));
+                if (k != quantize(std::floor(v + 0.5)) && !(tie && neighbour)) {
+                    mismatches++;
+                }
+            }
+            std::cout << "op " << op << " scale " << q.scale << " bias " << q.bias << " shift " << q.shift << ": "
+                      << (mismatches ? "FAIL" : "PASS") << " (" << ties << " near ties)" << std::endl;
+            failed += (mismatches != 0);
+        }
+    }
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+/*
+ * Model of the box_filter_integral window sums and of integralCombineTiles
+ *
+ * Replays the padded prefix row of the box kernel (running column sums,
+ * zero / last value padding, the aligned reads of box_load_at) and compares
+ * every window sum with a brute force sum clipped at the tile edges. Reads
+ * outside the padded row fail the model. Then stitches per tile
+ * summed-area tables of an uneven tile grid with integralCombineTiles and
+ * compares them with the integral of the image.
+ *
+ * Usage: box_model (returns 0 if every case matches)
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "integral_image.hpp"
+
+namespace {
+
+constexpr int N = 16;
+constexpr int MAX_R = 16;
+constexpr int PAD = (MAX_R + 15) / 8 * 8;
+
+using Image = std::vector<int16_t>;
+
+int64_t bruteSum(const Image& in, int width, int height, int i, int j, int r) {
+    int64_t s = 0;
+    for (int y = std::max(i - r, 0); y <= std::min(i + r, height - 1); y++)
+        for (int x = std::max(j - r, 0); x <= std::min(j + r, width - 1); x++) s += in[y * width + x];
+    return s;
+}
+
+// Window sums of the kernel, false if a read leaves the padded row
+bool laneModel(const Image& in, int width, int height, int r, std::vector<int64_t>& sums) {
+    std::vector<int64_t> col_sum(width, 0);
+    std::vector<int64_t> prefix(PAD + width + PAD);
+    for (int y = 0; y < std::min(r, height); y++)
+        for (int x = 0; x < width; x++) col_sum[x] += in[y * width + x];
+
+    for (int i = 0; i < height; i++) {
+        for (int x = 0; x < width; x++) {
+            if (i + r < height) col_sum[x] += in[(i + r) * width + x];
+            if (i - r - 1 >= 0) col_sum[x] -= in[(i - r - 1) * width + x];
+        }
+        std::fill(prefix.begin(), prefix.begin() + PAD, 0);
+        for (int x = 0; x < width; x++) prefix[PAD + x] = col_sum[x] + (x ? prefix[PAD + x - 1] : 0);
+        std::fill(prefix.begin() + PAD + width, prefix.end(), prefix[PAD + width - 1]);
+
+        for (int j = 0; j < width; j += N) {
+            // box_load_at(row, x) reads row[(x & ~7) .. (x & ~7) + 23]
+            auto loadAt = [&](int x, int l, int64_t& v) {
+                const int base = PAD + (x & ~7);
+                if (base < 0 || base + 23 >= (int)prefix.size()) return false;
+                v = prefix[PAD + x + l];
+                return true;
+            };
+            for (int l = 0; l < N; l++) {
+                int64_t hi, lo;
+                if (!loadAt(j + r, l, hi) || !loadAt(j - r - 1, l, lo)) return false;
+                sums[i * width + j + l] = hi - lo;
+            }
+        }
+    }
+    return true;
+}
+
+bool checkCombine(int width, int height, const std::vector<int>& xs, const std::vector<int>& ys) {
+    Image in(width * height);
+    for (auto& p : in) p = (int16_t)(rand() % 65536 - 32768);
+
+    // Stitched per tile tables, tiles in the order a tiler emits them
+    std::vector<int32_t> sat(width * height);
+    std::vector<std::array<int, 2> > origins;
+    for (size_t ty = 0; ty < ys.size(); ty++) {
+        for (size_t tx = 0; tx < xs.size(); tx++) {
+            const int x0 = xs[tx], x1 = (tx + 1 < xs.size()) ? xs[tx + 1] : width;
+            const int y0 = ys[ty], y1 = (ty + 1 < ys.size()) ? ys[ty + 1] : height;
+            origins.push_back({x0, y0});
+            for (int y = y0; y < y1; y++)
+                for (int x = x0; x < x1; x++) {
+                    uint32_t s = (uint32_t)(int32_t)in[y * width + x];
+                    if (y > y0) s += (uint32_t)sat[(y - 1) * width + x];
+                    if (x > x0) s += (uint32_t)sat[y * width + x - 1];
+                    if (y > y0 && x > x0) s -= (uint32_t)sat[(y - 1) * width + x - 1];
+                    sat[y * width + x] = (int32_t)s;
+                }
+        }
+    }
+    std::reverse(origins.begin(), origins.end()); // order must not matter
+    integralCombineTiles(sat.data(), width, height, origins);
+
+    std::vector<uint32_t> col(width, 0);
+    for (int y = 0; y < height; y++) {
+        uint32_t expect_row = 0;
+        for (int x = 0; x < width; x++) {
+            expect_row += (uint32_t)(int32_t)in[y * width + x];
+            col[x] += expect_row;
+            if ((uint32_t)sat[y * width + x] != col[x]) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const int sizes[][2] = {{64, 64}, {128, 32}, {16, 5}, {48, 40}};
+    const int radii[] = {0, 1, 3, 7, 16};
+
+    srand(1);
+    int failed = 0;
+    for (const auto& s : sizes) {
+        const int width = s[0];
+        const int height = s[1];
+        Image in(width * height);
+        for (auto& p : in) p = (int16_t)(rand() % 65536 - 32768);
+        for (int r : radii) {
+            std::vector<int64_t> sums(width * height);
+            bool match = laneModel(in, width, height, r, sums);
+            for (int i = 0; match && i < height; i++)
+                for (int j = 0; match && j < width; j++)
+                    match = (sums[i * width + j] == bruteSum(in, width, height, i, j, r));
+            std::cout << "box " << width << "x" << height << " radius " << r << ": " << (match ? "PASS" : "FAIL")
+                      << std::endl;
+            failed += !match;
+        }
+    }
+
+    const bool combined = checkCombine(100, 70, {0, 32, 64, 96}, {0, 30, 60}) && checkCombine(64, 64, {0}, {0});
+    std::cout << "integralCombineTiles: " << (combined ? "PASS" : "FAIL") << std::endl;
+    failed += !combined;
+
+    return (failed == 0) ? 0 : 1;
+}
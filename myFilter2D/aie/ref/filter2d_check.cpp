@@ -0,0 +1,253 @@
+/*
+ * Regression harness for the 16-bit filter2D AIE kernels
+ *
+ * Runs the bit-exact reference on the tiles of a PLIO input file and compares
+ * the result with the simulator (or hardware) output, tile by tile.
+ *
+ * Usage: filter2d_check <input.txt> <output.txt> [options]
+ *   -m model       kernel to model (default k3):
+ *                    k3     filter2D_k3_border, gaussian_k3_border
+ *                    sym    filter2D_k3_sym_border
+ *                    k5/k7  filter2D_kn_border<5/7>
+ *                    sep3/sep5/sep7  filter2D_separable_border<3/5/7>
+ *                    gauss5 gaussian_k5_sym_border
+ *                    unsharp unsharp_k3_border, amount in coeff[15]
+ *                    log5   log_k5_border, signed output
+ *   -k c0,c1,..    coefficients as the kernel's RTP: 16 values, K * 16 for
+ *                  k5/k7 (defaults: blur for k3/sym/sep3/gauss5/unsharp,
+ *                  logCoeffK5(1.0) with -s 14 for log5)
+ *   -s shift       SRS shift RTP (default 10), the two pass kernels split it
+ *                  into shift - shift / 2 (horizontal) and shift / 2 (vertical)
+ *   -r mode        rounding: floor, ceil, pos_inf, neg_inf, sym_inf, sym_zero, conv_even
+ *   -o file        write the reference output in PLIO format
+ *
+ * sym and log5 pre-add pixels in int16, pixels beyond 14 bits make them
+ * deviate from the exact convolution, which is reported as a warning.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+
+#include <common/xf_aie_utils.hpp>
+#include <imgproc/xf_filter_const.hpp>
+
+#include "filter2d_ref.hpp"
+
+using namespace xF::ref;
+using namespace xf::cv::aie;
+
+static void usage(const char* name) {
+    std::cerr << "Usage: " << name << " <input.txt> <output.txt> [-m model] [-k c0,c1,..] [-s shift] [-r rounding]"
+              << " [-o file]" << std::endl;
+}
+
+// Number of RTP coefficients, default kernel (empty: -k is required) and
+// whether the kernel flags its output for signed saturation
+struct ModelInfo {
+    size_t coeffs;
+    std::vector<int16_t> defaults;
+    bool signedOutput = false;
+};
+
+static const std::vector<int16_t> BLUR_K3 = {64, 128, 0, 64, 0, 128, 256, 0, 128, 0, 64, 128, 0, 64, 0, 0};
+
+static const std::map<std::string, ModelInfo> MODELS = {
+    {"k3", {16, BLUR_K3}},
+    {"sym", {16, BLUR_K3}},
+    {"k5", {5 * 16, {}}},
+    {"k7", {7 * 16, {}}},
+    {"sep3", {16, {8, 16, 8, 0, 0, 0, 0, 0, 8, 16, 8, 0, 0, 0, 0, 0}}},
+    {"sep5", {16, {}}},
+    {"sep7", {16, {}}},
+    {"gauss5", {16, {12, 8, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}},
+    {"unsharp", {16, {64, 128, 0, 64, 0, 128, 256, 0, 128, 0, 64, 128, 0, 64, 0, 256}}},
+    {"log5", {16, {-5120, -1484, 803, -1484, 97, 740, 803, 740, 384, 0, 0, 0, 0, 0, 0, 0}, true}}};
+
+using TileFilter = std::function<void(const int16_t*, int16_t*, int, int)>;
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    const std::string inputFile = argv[1];
+    const std::string outputFile = argv[2];
+    std::string refFile;
+
+    std::vector<int16_t> coeff;
+    int shift = FILTER2D_SRS_SHIFT;
+    RoundingMode mode = RND_FLOOR;
+    std::string model = "k3";
+
+    const std::map<std::string, RoundingMode> modes = {
+        {"floor", RND_FLOOR},     {"ceil", RND_CEIL},         {"pos_inf", RND_POS_INF},    {"neg_inf", RND_NEG_INF},
+        {"sym_inf", RND_SYM_INF}, {"sym_zero", RND_SYM_ZERO}, {"conv_even", RND_CONV_EVEN}};
+
+    for (int i = 3; i < argc; i++) {
+        if (!strcmp(argv[i], "-k") && (i + 1 < argc)) {
+            std::istringstream ss(argv[++i]);
+            std::string tok;
+            coeff.clear();
+            while (std::getline(ss, tok, ',')) coeff.push_back((int16_t)std::stoi(tok));
+        } else if (!strcmp(argv[i], "-s") && (i + 1 < argc)) {
+            shift = std::atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-m") && (i + 1 < argc)) {
+            model = argv[++i];
+            if (!MODELS.count(model)) {
+                std::cerr << "ERR: unknown model " << model << std::endl;
+                return 2;
+            }
+        } else if (!strcmp(argv[i], "-r") && (i + 1 < argc)) {
+            auto it = modes.find(argv[++i]);
+            if (it == modes.end()) {
+                std::cerr << "ERR: unknown rounding mode " << argv[i] << std::endl;
+                return 2;
+            }
+            mode = it->second;
+        } else if (!strcmp(argv[i], "-o") && (i + 1 < argc)) {
+            refFile = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const auto inTiles = splitTiles(readPlioFile(inputFile));
+    if (inTiles.empty()) {
+        std::cerr << "ERR: no tiles found in " << inputFile << std::endl;
+        return 2;
+    }
+
+    const ModelInfo& info = MODELS.at(model);
+    if (coeff.empty()) coeff = info.defaults;
+    if (coeff.size() != info.coeffs) {
+        std::cerr << "ERR: model " << model << " expects " << info.coeffs << " coefficients (-k)" << std::endl;
+        return 2;
+    }
+
+    const int shiftH = shift - shift / 2;
+    const int shiftV = shift / 2;
+    TileFilter filter;
+    Kernel exact{0, {}}; // convolution a pre-adding model has to match
+    if (model == "k3" || model == "sym" || model == "unsharp") {
+        int16_t k3[16];
+        std::copy(coeff.begin(), coeff.end(), k3);
+        const Kernel kernel = kernelFromK3Layout(k3);
+        if (model == "sym" && !isSymmetricK3(kernel)) {
+            std::cerr << "ERR: the symmetric kernel needs coefficients of the form a b a / c d c / a b a"
+                      << std::endl;
+            return 2;
+        }
+        if (model == "sym") exact = kernel;
+        filter = [=](const int16_t* in, int16_t* out, int width, int height) {
+            if (model == "sym") {
+                filter2DSym(in, out, width, height, kernel, shift, mode);
+            } else if (model == "unsharp") {
+                unsharp(in, out, width, height, kernel, k3[15], shift, UNSHARP_AMOUNT_BITS, mode);
+            } else {
+                filter2D(in, out, width, height, kernel, shift, mode);
+            }
+        };
+    } else if (model == "k5" || model == "k7") {
+        const Kernel kernel = kernelFromRowLayout(coeff.data(), model == "k5" ? 5 : 7);
+        filter = [=](const int16_t* in, int16_t* out, int width, int height) {
+            filter2D(in, out, width, height, kernel, shift, mode);
+        };
+    } else if (model == "log5") {
+        filter = [=](const int16_t* in, int16_t* out, int width, int height) {
+            log5Sym(in, out, width, height, coeff.data(), shift, mode);
+        };
+        exact = kernelFromLog5(coeff.data());
+    } else if (model == "gauss5") {
+        filter = [=](const int16_t* in, int16_t* out, int width, int height) {
+            gaussian5Sym(in, out, width, height, coeff.data(), shiftH, shiftV, mode);
+        };
+    } else {
+        const int size = model[3] - '0';
+        filter = [=](const int16_t* in, int16_t* out, int width, int height) {
+            filter2DSeparable(in, out, width, height, size, coeff.data(), shiftH, shiftV, mode);
+        };
+    }
+
+    std::vector<int16_t> refSamples;
+    std::vector<std::vector<int16_t> > refTiles;
+    for (const auto& tile : inTiles) {
+        refTiles.push_back(processTile(tile, filter));
+        if (info.signedOutput) xfSignedSaturation(refTiles.back().data());
+        refSamples.insert(refSamples.end(), refTiles.back().begin(), refTiles.back().end());
+
+        if (exact.size) {
+            const auto conv = filter2DTile(tile, exact, shift, mode);
+            int wrapped = 0;
+            for (size_t n = METADATA_ELEMENTS; n < conv.size(); n++) wrapped += (conv[n] != refTiles.back()[n]);
+            if (wrapped) {
+                std::cerr << "WARN: tile " << refTiles.size() - 1 << ": " << wrapped
+                          << " outputs differ from the exact convolution, input exceeds 14 bits" << std::endl;
+            }
+        }
+    }
+
+    if (!refFile.empty()) {
+        writePlioFile(refFile, refSamples);
+    }
+
+    const auto outTiles = splitTiles(readPlioFile(outputFile));
+
+    int failedTiles = 0;
+    for (size_t t = 0; t < refTiles.size(); t++) {
+        const auto& ref = refTiles[t];
+        const int width = ref[POS_MDS_TILEWIDTH];
+        const int height = ref[POS_MDS_TILEHEIGHT];
+
+        std::cout << "Tile " << t << " (posV " << ref[POS_MDS_POSITIONV] << ", posH " << ref[POS_MDS_POSITIONH]
+                  << ", " << width << "x" << height << "): ";
+
+        if (t >= outTiles.size() || outTiles[t].size() != ref.size()) {
+            std::cout << "MISSING" << std::endl;
+            failedTiles++;
+            continue;
+        }
+
+        const auto& out = outTiles[t];
+        int mismatches = 0;
+        int maxDiff = 0;
+        int firstRow = -1, firstCol = -1;
+        for (int m = 0; m < METADATA_ELEMENTS; m++) {
+            if (out[m] != ref[m]) mismatches++;
+        }
+        for (int i = 0; i < height; i++) {
+            for (int j = 0; j < width; j++) {
+                const int idx = METADATA_ELEMENTS + i * width + j;
+                const int diff = std::abs(out[idx] - ref[idx]);
+                if (diff != 0) {
+                    if (firstRow < 0) {
+                        firstRow = i;
+                        firstCol = j;
+                    }
+                    mismatches++;
+                    maxDiff = std::max(maxDiff, diff);
+                }
+            }
+        }
+
+        if (mismatches == 0) {
+            std::cout << "PASS" << std::endl;
+        } else {
+            failedTiles++;
+            std::cout << "FAIL, " << mismatches << " mismatches, max diff " << maxDiff;
+            if (firstRow >= 0) {
+                const int idx = METADATA_ELEMENTS + firstRow * width + firstCol;
+                std::cout << ", first at (" << firstRow << "," << firstCol << ") expected " << ref[idx] << " got "
+                          << out[idx];
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    std::cout << (refTiles.size() - failedTiles) << "/" << refTiles.size() << " tiles match" << std::endl;
+    return (failedTiles == 0) ? 0 : 1;
+}
@@ -0,0 +1,345 @@
+/*
+ * Bit-exact host reference of the 16-bit filter2D AIE kernels
+ *
+ * Models filter2D_k3_border (and the KxK variants): products are summed in a
+ * 48-bit accumulator, rounded by srs(acc, shift) and the tile borders are
+ * replicated. filter2DSym models the pre-adders of filter2D_k3_sym_border,
+ * log5Sym those of log_k5_border,
+ * filter2DSeparable and gaussian5Sym the two pass kernels including the
+ * rounding of their intermediate row, unsharp the fused unsharp mask.
+ * Tiles follow the window layout used by the tiler: 32 int16 metadata
+ * elements followed by width x height pixels.
+ */
+
+#ifndef _FILTER2D_REF_HPP_
+#define _FILTER2D_REF_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <common/xf_aie_const.hpp>
+
+namespace xF {
+namespace ref {
+
+// AIE rounding modes used by srs (reset value is FLOOR)
+enum RoundingMode { RND_FLOOR, RND_CEIL, RND_POS_INF, RND_NEG_INF, RND_SYM_INF, RND_SYM_ZERO, RND_CONV_EVEN };
+
+// Wrap a value to the 48-bit accumulator range
+inline int64_t acc48(int64_t v) {
+    return (int64_t)((uint64_t)v << 16) >> 16;
+}
+
+// Shift-round-saturate of one accumulator lane
+inline int16_t srs(int64_t acc, int shift, RoundingMode mode = RND_FLOOR, bool saturate = true) {
+    acc = acc48(acc);
+    int64_t q = acc;
+    if (shift > 0) {
+        const int64_t one = (int64_t)1 << shift;
+        const int64_t half = one >> 1;
+        const int64_t floor_q = acc >> shift; // arithmetic shift floors
+        const int64_t rem = acc - floor_q * one;
+        switch (mode) {
+            case RND_CEIL:
+                q = floor_q + (rem != 0);
+                break;
+            case RND_POS_INF:
+                q = floor_q + (rem >= half);
+                break;
+            case RND_NEG_INF:
+                q = floor_q + (rem > half);
+                break;
+            case RND_SYM_INF:
+                q = (acc >= 0) ? floor_q + (rem >= half) : floor_q + (rem > half);
+                break;
+            case RND_SYM_ZERO:
+                q = (acc >= 0) ? floor_q + (rem > half) : floor_q + (rem >= half);
+                break;
+            case RND_CONV_EVEN:
+                q = floor_q + ((rem > half) || ((rem == half) && (floor_q & 1)));
+                break;
+            default:
+                q = floor_q;
+                break;
+        }
+    }
+    if (saturate) {
+        q = std::min<int64_t>(std::max<int64_t>(q, INT16_MIN), INT16_MAX);
+    }
+    return (int16_t)q;
+}
+
+// Square KxK kernel, row major
+struct Kernel {
+    int size;
+    std::vector<int16_t> taps;
+};
+
+// filter2D_k3_border layout: k0 k1 0 k2 0 k3 k4 0 k5 0 k6 k7 0 k8 0 0
+inline Kernel kernelFromK3Layout(const int16_t (&coeff)[16]) {
+    return {3, {coeff[0], coeff[1], coeff[3], coeff[5], coeff[6], coeff[8], coeff[10], coeff[11], coeff[13]}};
+}
+
+// filter2D_kn_border / filter2D_stream_border layout: row r at coeff[16 * r]
+inline Kernel kernelFromRowLayout(const int16_t* coeff, int size) {
+    Kernel k{size, {}};
+    for (int r = 0; r < size; r++) {
+        for (int c = 0; c < size; c++) {
+            k.taps.push_back(coeff[16 * r + c]);
+        }
+    }
+    return k;
+}
+
+// Filters one tile of image data (no metadata) with replicated borders
+inline void filter2D(const int16_t* in,
+                     int16_t* out,
+                     int width,
+                     int height,
+                     const Kernel& kernel,
+                     int shift,
+                     RoundingMode mode = RND_FLOOR) {
+    const int R = kernel.size / 2;
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            int64_t acc = 0;
+            for (int r = 0; r < kernel.size; r++) {
+                const int y = std::min(std::max(i + r - R, 0), height - 1);
+                for (int c = 0; c < kernel.size; c++) {
+                    const int x = std::min(std::max(j + c - R, 0), width - 1);
+                    acc = acc48(acc + (int64_t)kernel.taps[r * kernel.size + c] * in[y * width + x]);
+                }
+            }
+            out[i * width + j] = srs(acc, shift, mode);
+        }
+    }
+}
+
+// Kernel of the form a b a / c d c / a b a, the only taps
+// filter2D_k3_sym_border reads are a, b, c and d
+inline bool isSymmetricK3(const Kernel& kernel) {
+    const std::vector<int16_t>& k = kernel.taps;
+    return (kernel.size == 3) && (k[0] == k[2]) && (k[0] == k[6]) && (k[0] == k[8]) && (k[1] == k[7]) &&
+           (k[3] == k[5]);
+}
+
+// Model of filter2D_k3_sym_border: the row pair d[i-1] + d[i+1] and the
+// mirrored column pairs go through int16 pre-adders and wrap, matches
+// filter2D() for pixel data of up to 14 bits
+inline void filter2DSym(const int16_t* in,
+                        int16_t* out,
+                        int width,
+                        int height,
+                        const Kernel& kernel,
+                        int shift,
+                        RoundingMode mode = RND_FLOOR) {
+    const int64_t a = kernel.taps[0], b = kernel.taps[1], c = kernel.taps[3], d = kernel.taps[4];
+    std::vector<int16_t> s(width);
+    for (int i = 0; i < height; i++) {
+        const int16_t* top = in + std::max(i - 1, 0) * width;
+        const int16_t* mid = in + i * width;
+        const int16_t* bottom = in + std::min(i + 1, height - 1) * width;
+        for (int j = 0; j < width; j++) s[j] = (int16_t)(top[j] + bottom[j]);
+        for (int j = 0; j < width; j++) {
+            const int l = std::max(j - 1, 0);
+            const int r = std::min(j + 1, width - 1);
+            const int64_t acc = a * (int16_t)(s[l] + s[r]) + b * s[j] + c * (int16_t)(mid[l] + mid[r]) + d * mid[j];
+            out[i * width + j] = srs(acc, shift, mode);
+        }
+    }
+}
+
+// Full 5x5 kernel of the 9 unique values L(dy, dx) = coeff[3 * dy + dx] of
+// log_k5_border (symmetric about both axes)
+inline Kernel kernelFromLog5(const int16_t* coeff) {
+    Kernel k{5, {}};
+    for (int r = -2; r <= 2; r++) {
+        for (int c = -2; c <= 2; c++) {
+            k.taps.push_back(coeff[3 * std::abs(r) + std::abs(c)]);
+        }
+    }
+    return k;
+}
+
+// Model of log_k5_border: the row pairs d[i-2] + d[i+2], d[i-1] + d[i+1]
+// and then the mirrored column pairs go through int16 pre-adders and wrap,
+// so the corner taps see the sum of four pixels. Matches filter2D() of
+// kernelFromLog5() for pixel data of up to 14 bits.
+inline void log5Sym(const int16_t* in,
+                    int16_t* out,
+                    int width,
+                    int height,
+                    const int16_t* coeff,
+                    int shift,
+                    RoundingMode mode = RND_FLOOR) {
+    std::vector<int16_t> s[3];
+    auto row = [&](int y) { return in + std::min(std::max(y, 0), height - 1) * width; };
+    for (int i = 0; i < height; i++) {
+        for (int dy = 0; dy < 3; dy++) {
+            s[dy].resize(width);
+            for (int j = 0; j < width; j++) {
+                s[dy][j] = dy ? (int16_t)(row(i - dy)[j] + row(i + dy)[j]) : row(i)[j];
+            }
+        }
+        for (int j = 0; j < width; j++) {
+            int64_t acc = 0;
+            for (int dy = 0; dy < 3; dy++) {
+                auto v = [&](int x) { return s[dy][std::min(std::max(x, 0), width - 1)]; };
+                acc += (int64_t)coeff[3 * dy] * v(j) + (int64_t)coeff[3 * dy + 1] * (int16_t)(v(j - 1) + v(j + 1)) +
+                       (int64_t)coeff[3 * dy + 2] * (int16_t)(v(j - 2) + v(j + 2));
+            }
+            out[i * width + j] = srs(acc, shift, mode);
+        }
+    }
+}
+
+// Model of filter2D_separable_border<K>: coeff[0 .. K-1] are the horizontal,
+// coeff[8 .. 8+K-1] the vertical taps. The vertical pass is rounded with
+// shift_v into a row buffer, the horizontal pass with shift_h.
+inline void filter2DSeparable(const int16_t* in,
+                              int16_t* out,
+                              int width,
+                              int height,
+                              int size,
+                              const int16_t* coeff,
+                              int shift_h,
+                              int shift_v,
+                              RoundingMode mode = RND_FLOOR) {
+    const int R = size / 2;
+    std::vector<int16_t> line(width);
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            int64_t acc = 0;
+            for (int r = 0; r < size; r++) {
+                const int y = std::min(std::max(i + r - R, 0), height - 1);
+                acc = acc48(acc + (int64_t)coeff[8 + r] * in[y * width + j]);
+            }
+            line[j] = srs(acc, shift_v, mode);
+        }
+        for (int j = 0; j < width; j++) {
+            int64_t acc = 0;
+            for (int c = 0; c < size; c++) {
+                const int x = std::min(std::max(j + c - R, 0), width - 1);
+                acc = acc48(acc + (int64_t)coeff[c] * line[x]);
+            }
+            out[i * width + j] = srs(acc, shift_h, mode);
+        }
+    }
+}
+
+// Model of gaussian_k5_sym_border: taps g0 (centre), g1, g2 in coeff[0 .. 2],
+// mirrored rows and columns are pre-added in int16 and wrap
+inline void gaussian5Sym(const int16_t* in,
+                         int16_t* out,
+                         int width,
+                         int height,
+                         const int16_t* coeff,
+                         int shift_h,
+                         int shift_v,
+                         RoundingMode mode = RND_FLOOR) {
+    const int64_t g0 = coeff[0], g1 = coeff[1], g2 = coeff[2];
+    std::vector<int16_t> line(width);
+    auto row = [&](int y) { return in + std::min(std::max(y, 0), height - 1) * width; };
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            const int16_t inner = (int16_t)(row(i - 1)[j] + row(i + 1)[j]);
+            const int16_t outer = (int16_t)(row(i - 2)[j] + row(i + 2)[j]);
+            line[j] = srs(g0 * row(i)[j] + g1 * inner + g2 * outer, shift_v, mode);
+        }
+        for (int j = 0; j < width; j++) {
+            auto v = [&](int x) { return line[std::min(std::max(x, 0), width - 1)]; };
+            const int16_t inner = (int16_t)(v(j - 1) + v(j + 1));
+            const int16_t outer = (int16_t)(v(j - 2) + v(j + 2));
+            out[i * width + j] = srs(g0 * v(j) + g1 * inner + g2 * outer, shift_h, mode);
+        }
+    }
+}
+
+// Model of unsharp_k3_border: the blur is rounded with 'shift' like
+// filter2D(), then o = src * (1 + a) - blur * a with the amount a in
+// Q.amountBits (kernel UNSHARP_AMOUNT_BITS)
+inline void unsharp(const int16_t* in,
+                    int16_t* out,
+                    int width,
+                    int height,
+                    const Kernel& kernel,
+                    int16_t amount,
+                    int shift,
+                    int amountBits,
+                    RoundingMode mode = RND_FLOOR) {
+    filter2D(in, out, width, height, kernel, shift, mode);
+    const int16_t onePlusAmount = (int16_t)((1 << amountBits) + amount);
+    for (int n = 0; n < width * height; n++) {
+        out[n] = srs((int64_t)in[n] * onePlusAmount - (int64_t)out[n] * amount, amountBits, mode);
+    }
+}
+
+// Applies filter(in, out, width, height) to one window (metadata + tile),
+// metadata is copied like the kernels do
+template <typename Filter>
+inline std::vector<int16_t> processTile(const std::vector<int16_t>& tile, Filter filter) {
+    using namespace xf::cv::aie;
+    std::vector<int16_t> out(tile);
+    const int width = tile[POS_MDS_TILEWIDTH];
+    const int height = tile[POS_MDS_TILEHEIGHT];
+    filter(tile.data() + METADATA_ELEMENTS, out.data() + METADATA_ELEMENTS, width, height);
+    return out;
+}
+
+inline std::vector<int16_t> filter2DTile(const std::vector<int16_t>& tile,
+                                         const Kernel& kernel,
+                                         int shift,
+                                         RoundingMode mode = RND_FLOOR) {
+    return processTile(tile, [&](const int16_t* in, int16_t* out, int width, int height) {
+        filter2D(in, out, width, height, kernel, shift, mode);
+    });
+}
+
+// PLIO text files: whitespace separated samples, simulator timestamps
+// ("T 4486400 ps") and TLAST markers are skipped
+inline std::vector<int16_t> readPlioFile(const std::string& path) {
+    std::vector<int16_t> samples;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream ss(line);
+        std::string token;
+        while (ss >> token) {
+            if (token[0] == 'T' || token == "ps" || token == "ns" || token == "us") break;
+            samples.push_back((int16_t)std::stol(token));
+        }
+    }
+    return samples;
+}
+
+inline void writePlioFile(const std::string& path, const std::vector<int16_t>& samples, int perLine = 8) {
+    std::ofstream file(path);
+    for (size_t i = 0; i < samples.size(); i++) {
+        file << samples[i] << (((i + 1) % perLine == 0) ? "\n" : " ");
+    }
+}
+
+// Splits a PLIO stream into windows using the tile size in each header
+inline std::vector<std::vector<int16_t> > splitTiles(const std::vector<int16_t>& samples) {
+    using namespace xf::cv::aie;
+    std::vector<std::vector<int16_t> > tiles;
+    size_t pos = 0;
+    while (pos + METADATA_ELEMENTS <= samples.size()) {
+        const size_t elems =
+            METADATA_ELEMENTS + (size_t)samples[pos + POS_MDS_TILEWIDTH] * samples[pos + POS_MDS_TILEHEIGHT];
+        if (pos + elems > samples.size()) break;
+        tiles.emplace_back(samples.begin() + pos, samples.begin() + pos + elems);
+        pos += elems;
+    }
+    return tiles;
+}
+
+} // namespace ref
+} // namespace xF
+
+#endif //_FILTER2D_REF_HPP_
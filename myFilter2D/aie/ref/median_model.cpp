@@ -0,0 +1,84 @@
+/*
+ * Model of the median_border compare-exchange networks
+ *
+ * Runs MEDIAN9_NETWORK (after the column pre-sort of median_k3_block) and
+ * MEDIAN25_NETWORK on scalar inputs and compares the selected element with
+ * the median of the sorted window. 3x3 is checked on every 0-1 input, which
+ * proves the network for any data (0-1 principle), both sizes on random
+ * windows.
+ *
+ * Usage: median_model (returns 0 if every window matches)
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include <imgproc/xf_median_network.hpp>
+
+using namespace xf::cv::aie;
+
+namespace {
+
+void cmpx(int16_t& a, int16_t& b) {
+    const int16_t lo = std::min(a, b);
+    b = std::max(a, b);
+    a = lo;
+}
+
+// w[3 * r + c]: row r, column c of the window
+int16_t median9(const int16_t* w) {
+    int16_t col[3][3];
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) col[c][r] = w[3 * r + c];
+        cmpx(col[c][1], col[c][2]);
+        cmpx(col[c][0], col[c][1]);
+        cmpx(col[c][1], col[c][2]);
+    }
+    // p[3 * c + r]: rank r of column c
+    int16_t p[9];
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) p[3 * c + r] = col[c][r];
+    }
+    for (const auto& e : MEDIAN9_NETWORK) cmpx(p[e[0]], p[e[1]]);
+    return p[4];
+}
+
+int16_t median25(const int16_t* w) {
+    int16_t p[25];
+    std::copy(w, w + 25, p);
+    for (const auto& e : MEDIAN25_NETWORK) cmpx(p[e[0]], p[e[1]]);
+    return p[12];
+}
+
+int16_t sortedMedian(const int16_t* w, int n) {
+    int16_t s[25];
+    std::copy(w, w + n, s);
+    std::sort(s, s + n);
+    return s[n / 2];
+}
+
+} // namespace
+
+int main() {
+    int failed = 0;
+    int16_t w[25];
+
+    for (int bits = 0; bits < (1 << 9); bits++) {
+        for (int k = 0; k < 9; k++) w[k] = (bits >> k) & 1;
+        failed += (median9(w) != sortedMedian(w, 9));
+    }
+    std::cout << "3x3 0-1 inputs: " << (failed ? "FAIL" : "PASS") << std::endl;
+
+    srand(1);
+    int failedRandom = 0;
+    for (int t = 0; t < 100000; t++) {
+        for (auto& p : w) p = (int16_t)(rand() % 64 - 32); // few values, many ties
+        failedRandom += (median9(w) != sortedMedian(w, 9));
+        failedRandom += (median25(w) != sortedMedian(w, 25));
+    }
+    std::cout << "3x3 / 5x5 random windows: " << (failedRandom ? "FAIL" : "PASS") << std::endl;
+
+    return (failed + failedRandom == 0) ? 0 : 1;
+}
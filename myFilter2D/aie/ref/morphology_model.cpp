@@ -0,0 +1,119 @@
+/*
+ * Lane model of morphology_rect_api
+ *
+ * Replays the vertical van Herk/Gil-Werman pass and the horizontal doubling
+ * pass of the kernel lane by lane (N = 16, int16) and compares the result
+ * with a brute force min/max filter with replicated borders. Lanes the
+ * kernel must never read (the tail of shuffle_down) are filled with the
+ * value that would corrupt the result.
+ *
+ * Usage: morphology_model (returns 0 if every case matches)
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr int N = 16;
+constexpr int HALF = N / 2;
+
+using Image = std::vector<int16_t>;
+
+int16_t op(bool dilate, int16_t a, int16_t b) {
+    return dilate ? std::max(a, b) : std::min(a, b);
+}
+
+Image bruteForce(const Image& in, int width, int height, int kw, int kh, bool dilate) {
+    Image out(in.size());
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            int16_t m = in[i * width + j];
+            for (int r = -kh / 2; r <= kh / 2; r++) {
+                for (int c = -kw / 2; c <= kw / 2; c++) {
+                    const int y = std::min(std::max(i + r, 0), height - 1);
+                    const int x = std::min(std::max(j + c, 0), width - 1);
+                    m = op(dilate, m, in[y * width + x]);
+                }
+            }
+            out[i * width + j] = m;
+        }
+    }
+    return out;
+}
+
+Image laneModel(const Image& in, int width, int height, int kw, int kh, bool dilate) {
+    const int rw = kw / 2;
+    const int rh = kh / 2;
+    const int16_t poison = dilate ? INT16_MAX : INT16_MIN;
+    auto px = [&](int v, int x) { return in[std::min(std::max(v - rh, 0), height - 1) * width + x]; };
+
+    // Vertical pass, one column per lane
+    Image res(in.size());
+    const int rows = ((height + 2 * rh + kh - 1) / kh) * kh;
+    std::vector<int16_t> g(rows), h(rows);
+    for (int x = 0; x < width; x++) {
+        for (int b = 0; b < rows; b += kh) {
+            g[b] = px(b, x);
+            for (int v = b + 1; v < b + kh; v++) g[v] = op(dilate, g[v - 1], px(v, x));
+            h[b + kh - 1] = px(b + kh - 1, x);
+            for (int v = b + kh - 2; v >= b; v--) h[v] = op(dilate, h[v + 1], px(v, x));
+        }
+        for (int i = 0; i < height; i++) res[i * width + x] = op(dilate, h[i], g[i + kh - 1]);
+    }
+
+    // Horizontal pass by doubling, in place
+    std::vector<int16_t> line(HALF + width + HALF);
+    for (int i = 0; i < height; i++) {
+        int16_t* row = res.data() + i * width;
+        std::copy(row, row + width, line.begin() + HALF);
+        std::fill(line.begin(), line.begin() + HALF, row[0]);
+        std::fill(line.end() - HALF, line.end(), row[width - 1]);
+
+        for (int x = 0; x < width; x += N) {
+            std::vector<int16_t> d(line.begin() + x, line.begin() + x + 2 * N);
+            auto shuffleDown = [&](const std::vector<int16_t>& v, int n) {
+                std::vector<int16_t> s(2 * N, poison);
+                for (int t = 0; t + n < 2 * N; t++) s[t] = v[t + n];
+                return s;
+            };
+            auto combine = [&](int n) {
+                const std::vector<int16_t> s = shuffleDown(d, n);
+                for (int t = 0; t < 2 * N; t++) d[t] = op(dilate, d[t], s[t]);
+            };
+            int span = 1;
+            for (; 2 * span <= kw; span *= 2) combine(span);
+            if (span < kw) combine(kw - span);
+            const std::vector<int16_t> s = shuffleDown(d, HALF - rw);
+            std::copy(s.begin(), s.begin() + N, row + x);
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+int main() {
+    const int sizes[][2] = {{3, 3}, {9, 9}, {15, 15}, {17, 5}, {5, 13}};
+    const int width = 64;
+    const int height = 20;
+
+    srand(1);
+    Image in(width * height);
+    for (auto& p : in) p = (int16_t)(rand() - RAND_MAX / 2);
+
+    int failed = 0;
+    for (const auto& k : sizes) {
+        for (bool dilate : {false, true}) {
+            const bool match = laneModel(in, width, height, k[0], k[1], dilate) ==
+                               bruteForce(in, width, height, k[0], k[1], dilate);
+            std::cout << (dilate ? "dilate " : "erode ") << k[0] << "x" << k[1] << ": "
+                      << (match ? "PASS" : "FAIL") << std::endl;
+            failed += !match;
+        }
+    }
+    return (failed == 0) ? 0 : 1;
+}
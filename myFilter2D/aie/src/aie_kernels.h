@@ -6,7 +6,76 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "config.hpp"
 
-void filter2D(input_window_int16* input, output_window_int16* output);
+void filter2D(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void filter2D_8b(input_window_uint8* input, const int8_t (&coeff)[16], const int shift, output_window_uint8* output);
+void filter2D_separable(input_window_int16* input,
+                        const int16_t (&coeff)[16],
+                        const int shift,
+                        output_window_int16* output);
+void filter2D_separable_k5(input_window_int16* input,
+                           const int16_t (&coeff)[16],
+                           const int shift,
+                           output_window_int16* output);
+void filter2D_separable_k7(input_window_int16* input,
+                           const int16_t (&coeff)[16],
+                           const int shift,
+                           output_window_int16* output);
+void filter2D_symmetric(input_window_int16* input,
+                        const int16_t (&coeff)[16],
+                        const int shift,
+                        output_window_int16* output);
+void gaussian(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void gaussian_k5(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void unsharp(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void sobel_dx(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void sobel_dy(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void sobel_l1(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void canny_gradient(input_window_int16* input, output_window_int16* output);
+void canny_nms(input_window_int16* input, output_window_int16* output);
+void canny_threshold(input_window_int16* input, const int low, const int high, output_window_int16* output);
+void harris(input_window_int16* input, const int k, const int shift, output_window_int16* output);
+void erode_rect(input_window_int16* input, output_window_int16* output);
+void dilate_rect(input_window_int16* input, output_window_int16* output);
+void median3x3(input_window_int16* input, output_window_int16* output);
+void median5x5(input_window_int16* input, output_window_int16* output);
+void bilateral(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output);
+void laplacian_of_gaussian(input_window_int16* input,
+                           const int16_t (&coeff)[16],
+                           const int shift,
+                           output_window_int16* output);
+void integral(input_window_int16* input, output_window_int32* output);
+void box_filter(input_window_int16* input, const int radius, output_window_int16* output);
+void resize_bilinear(input_window_uint8* input, const int scale_x, const int scale_y, output_window_uint8* output);
+void resize_area(input_window_uint8* input, const int scale_x, const int scale_y, output_window_uint8* output);
+void resize_bicubic(input_window_uint8* input, const int scale_x, const int scale_y, output_window_uint8* output);
+void resize_letterbox(input_window_uint8* input,
+                      const int scale_x,
+                      const int scale_y,
+                      const int16_t (&params)[LETTERBOX_PARAMS],
+                      output_window_int8* output_r,
+                      output_window_int8* output_g,
+                      output_window_int8* output_b);
+void blob_from_image(input_window_float* input,
+                     const int op,
+                     const float alpha,
+                     const float beta,
+                     const float gama,
+                     const int threshold1,
+                     const int threshold2,
+                     output_window_float* output);
+void blob_from_image_int8(input_window_uint8* input,
+                          const int scale,
+                          const int bias,
+                          const int shift,
+                          const int lo,
+                          const int hi,
+                          output_window_int8* output);
+
+void filter2D_stream(input_stream_int16* input,
+                     const int16_t (&coeff)[FILTER_STREAM_COEFF_SIZE],
+                     const int shift,
+                     output_stream_int16* output);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "imgproc/xf_blobfromimage_aie.hpp"
+#include "aie_kernels.h"
+
+/*
+blobFromImage with the op and its constants as runtime parameters, float
+tiles or uint8 -> int8 quantized tiles (constants from blobQuantParams).
+*/
+
+void blob_from_image(input_window_float* input,
+                     const int op,
+                     const float alpha,
+                     const float beta,
+                     const float gama,
+                     const int threshold1,
+                     const int threshold2,
+                     output_window_float* output) {
+    xf::cv::aie::blobFromImage_api(input, output, op, alpha, beta, gama, threshold1, threshold2);
+};
+
+void blob_from_image_int8(input_window_uint8* input,
+                          const int scale,
+                          const int bias,
+                          const int shift,
+                          const int lo,
+                          const int hi,
+                          output_window_int8* output) {
+    xf::cv::aie::blobFromImage_int8(input, output, scale, bias, shift, lo, hi);
+};
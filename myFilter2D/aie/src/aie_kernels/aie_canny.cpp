@@ -0,0 +1,37 @@
+#include "aie_kernels.h"
+#include "imgproc/xf_canny_16b_aie.hpp"
+
+// Threshold type of the single threshold kernel in xf_threshold_aie.hpp,
+// which is compiled along with the Canny double threshold
+enum ThresholdType {
+    XF_THRESHOLD_TYPE_BINARY = 0,
+    XF_THRESHOLD_TYPE_BINARY_INV = 1,
+    XF_THRESHOLD_TYPE_TRUNC = 2,
+    XF_THRESHOLD_TYPE_TOZERO = 3,
+    XF_THRESHOLD_TYPE_TOZERO_INV = 4
+};
+#define THRESH_TYPE XF_THRESHOLD_TYPE_BINARY
+#include "imgproc/xf_threshold_aie.hpp"
+
+/*
+Canny stages after the Gaussian, see CannyGraph. The gradient stage packs
+magnitude and direction into one tile so that non-maximum suppression needs
+a single input window.
+*/
+
+void canny_gradient(input_window_int16* input, output_window_int16* output) {
+    xf::cv::aie::canny_gradient_k3_border(input, output);
+};
+
+void canny_nms(input_window_int16* input, output_window_int16* output) {
+    xf::cv::aie::canny_nms_k3_border(input, output);
+};
+
+/*
+Double threshold, strong edges 255 and weak edges 128. Thresholds are L1
+gradient magnitudes and arrive as runtime parameters.
+*/
+
+void canny_threshold(input_window_int16* input, const int low, const int high, output_window_int16* output) {
+    xf::cv::aie::double_threshold_api(input, output, low, high);
+};
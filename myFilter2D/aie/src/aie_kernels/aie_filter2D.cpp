@@ -1,13 +1,142 @@
-
 #include "imgproc/xf_filter2d_16b_aie.hpp"
+#include "imgproc/xf_filter2d_8b_aie.hpp"
+#include "imgproc/xf_gaussian_16b_aie.hpp"
+#include "imgproc/xf_unsharp_16b_aie.hpp"
+#include "imgproc/xf_sobel_16b_aie.hpp"
+#include "imgproc/xf_bilateral_16b_aie.hpp"
+#include "imgproc/xf_log_16b_aie.hpp"
 #include "aie_kernels.h"
 
 /*
-Floating point values of the kernel
-kData[9] = {0.0625, 0.125, 0.0625, 0.125, 0.25, 0.125, 0.0625, 0.125, 0.0625};
+Coefficients and SRS shift arrive through asynchronous runtime parameters,
+so the host can swap filters between frames with graph.update().
+*/
+
+void filter2D(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::filter2D_k3_border(input, coeff, output, shift);
+};
+
+/*
+Native 8-bit variant, uint8 pixels and int8 Q7 coefficients in the filter2D
+layout, 32 pixels per vector and saturated uint8 output.
+*/
+
+void filter2D_8b(input_window_uint8* input, const int8_t (&coeff)[16], const int shift, output_window_uint8* output) {
+    xf::cv::aie::filter2D_k3_border_8b(input, coeff, output, shift);
+};
+
+/*
+Separable variants (3x3, 5x5, 7x7), coeff[0..7] hold the horizontal taps and
+coeff[8..15] the vertical taps. The shift is split between the two passes,
+tiles up to 256 wide are supported, 5x5 / 7x7 need a tiler overlap of 2 / 3.
+*/
+
+void filter2D_separable(input_window_int16* input,
+                        const int16_t (&coeff)[16],
+                        const int shift,
+                        output_window_int16* output) {
+    xf::cv::aie::filter2D_separable_border<3>(input, coeff, output, shift - shift / 2, shift / 2);
+};
+
+void filter2D_separable_k5(input_window_int16* input,
+                           const int16_t (&coeff)[16],
+                           const int shift,
+                           output_window_int16* output) {
+    xf::cv::aie::filter2D_separable_border<5>(input, coeff, output, shift - shift / 2, shift / 2);
+};
+
+void filter2D_separable_k7(input_window_int16* input,
+                           const int16_t (&coeff)[16],
+                           const int shift,
+                           output_window_int16* output) {
+    xf::cv::aie::filter2D_separable_border<7>(input, coeff, output, shift - shift / 2, shift / 2);
+};
+
+/*
+Symmetric variant for kernels symmetric about both axes, same coefficient
+layout as filter2D but only k0, k1, k3 and k4 are read. Bit-identical to
+filter2D with fewer multiplies for pixel data of up to 14 bits.
+*/
+
+void filter2D_symmetric(input_window_int16* input,
+                        const int16_t (&coeff)[16],
+                        const int shift,
+                        output_window_int16* output) {
+    xf::cv::aie::filter2D_k3_sym_border(input, coeff, output, shift);
+};
+
+/*
+Gaussian 3x3 / 5x5, coefficients and shift computed on the host from sigma
+(see gaussian_coeff.hpp). The 5x5 takes the unique 1D taps {g0, g1, g2} and
+splits the shift between its vertical and horizontal pass.
+*/
+
+void gaussian(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::gaussian_k3_border(input, coeff, output, shift);
+};
+
+void gaussian_k5(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::gaussian_k5_sym_border(input, coeff, output, shift - shift / 2, shift / 2);
+};
+
+/*
+Unsharp mask, blur kernel in the filter2D layout with the sharpening amount
+in coeff[15] (see unsharpCoeffK3), one pass without an intermediate tile.
+*/
+
+void unsharp(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::unsharp_k3_border(input, coeff, output, shift);
+};
+
+/*
+Sobel gradients dx, dy or |dx| + |dy|, coeff[0..1] hold the smoothing taps
+({1, 2} Sobel, {3, 10} Scharr).
+*/
+
+void sobel_dx(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::sobel_k3_border<xf::cv::aie::SOBEL_DX>(input, coeff, output, shift);
+};
+
+void sobel_dy(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::sobel_k3_border<xf::cv::aie::SOBEL_DY>(input, coeff, output, shift);
+};
+
+void sobel_l1(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::sobel_k3_border<xf::cv::aie::SOBEL_L1>(input, coeff, output, shift);
+};
+
+/*
+Bilateral filter 3x3, coeff holds the spatial weights (filter2D layout, sum
+1024), 'shift' scales the range weights (range sigma 16 << shift).
+*/
+
+void bilateral(input_window_int16* input, const int16_t (&coeff)[16], const int shift, output_window_int16* output) {
+    xf::cv::aie::bilateral_k3_border(input, coeff, output, shift);
+};
+
+/*
+Laplacian of Gaussian 5x5 in one pass, coeff[3 * dy + dx] holds the 9 unique
+values (logCoeffK5), pixel data up to 14 bits, signed output, tiler overlap 2.
+*/
+
+void laplacian_of_gaussian(input_window_int16* input,
+                           const int16_t (&coeff)[16],
+                           const int shift,
+                           output_window_int16* output) {
+    xf::cv::aie::log_k5_border(input, coeff, output, shift);
+};
+
+/*
+Streaming variant, consumes STREAM_BAND_HEIGHT rows of STREAM_WIDTH pixels
+per run without metadata and keeps the vertical neighbourhood of the
+STREAM_FRAME_HEIGHT frame in a line buffer across runs.
+Coefficients use the 16-entry-per-row layout (see filter2D_stream_border).
 */
 
-void filter2D(input_window_int16* input, output_window_int16* output) {
-    const int16_t coeff[16] = {64, 128, 0, 64, 0, 128, 256, 0, 128, 0, 64, 128, 0, 64, 0, 0};
-    xf::cv::aie::filter2D_k3_border(input, coeff, output);
-};
\ No newline at end of file
+void filter2D_stream(input_stream_int16* input,
+                     const int16_t (&coeff)[FILTER_STREAM_COEFF_SIZE],
+                     const int shift,
+                     output_stream_int16* output) {
+    xf::cv::aie::filter2D_stream_border<3, STREAM_WIDTH>(input, coeff, output, STREAM_WIDTH, STREAM_BAND_HEIGHT,
+                                                         STREAM_FRAME_HEIGHT, shift);
+};
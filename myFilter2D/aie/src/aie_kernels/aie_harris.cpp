@@ -0,0 +1,11 @@
+#include "imgproc/xf_harris_16b_aie.hpp"
+#include "aie_kernels.h"
+
+/*
+Harris corner response, k in Q15 and the output shift arrive as runtime
+parameters so the detector can be tuned per scene.
+*/
+
+void harris(input_window_int16* input, const int k, const int shift, output_window_int16* output) {
+    xf::cv::aie::harris_k3_border(input, output, k, shift);
+};
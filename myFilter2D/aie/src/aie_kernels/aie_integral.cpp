@@ -0,0 +1,15 @@
+#include "imgproc/xf_integral_aie.hpp"
+#include "aie_kernels.h"
+
+/*
+Summed-area table per tile (int32 output tiles, no tiler overlap) and the
+constant time box filter built on it, radius as a runtime parameter.
+*/
+
+void integral(input_window_int16* input, output_window_int32* output) {
+    xf::cv::aie::integral_image(input, output);
+};
+
+void box_filter(input_window_int16* input, const int radius, output_window_int16* output) {
+    xf::cv::aie::box_filter_integral<TILE_WIDTH, BOX_MAX_RADIUS>(input, output, radius);
+};
@@ -0,0 +1,14 @@
+#include "imgproc/xf_median_16b_aie.hpp"
+#include "aie_kernels.h"
+
+/*
+Median filters, replicated borders, tiler overlap 1 (3x3) or 2 (5x5).
+*/
+
+void median3x3(input_window_int16* input, output_window_int16* output) {
+    xf::cv::aie::median_border<3>(input, output);
+};
+
+void median5x5(input_window_int16* input, output_window_int16* output) {
+    xf::cv::aie::median_border<5>(input, output);
+};
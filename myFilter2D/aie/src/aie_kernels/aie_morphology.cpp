@@ -0,0 +1,17 @@
+#include "imgproc/xf_morphology_aie.hpp"
+#include "aie_kernels.h"
+
+/*
+Rectangular erosion / dilation with a MORPH_KERNEL_W x MORPH_KERNEL_H
+structuring element, open and close are built in the graph by chaining both.
+*/
+
+void erode_rect(input_window_int16* input, output_window_int16* output) {
+    xf::cv::aie::morphology_rect_api<xf::cv::aie::MORPH_ERODE, int16_t, 16, MORPH_KERNEL_W, MORPH_KERNEL_H>(
+        input, output);
+};
+
+void dilate_rect(input_window_int16* input, output_window_int16* output) {
+    xf::cv::aie::morphology_rect_api<xf::cv::aie::MORPH_DILATE, int16_t, 16, MORPH_KERNEL_W, MORPH_KERNEL_H>(
+        input, output);
+};
@@ -0,0 +1,41 @@
+#include "imgproc/xf_resize_bilinear_aie.hpp"
+#include "imgproc/xf_resize_area_aie.hpp"
+#include "imgproc/xf_resize_bicubic_aie.hpp"
+#include "imgproc/xf_resize_letterbox_aie.hpp"
+#include "aie_kernels.h"
+
+/*
+Resize with the scale factors as runtime parameters (input / output size in
+Q16, see resizeScaleQ16), one output row per run, so a single graph serves
+every output resolution.
+*/
+
+void resize_bilinear(input_window_uint8* input, const int scale_x, const int scale_y, output_window_uint8* output) {
+    xf::cv::aie::resize_bilinear_rgba(input, output, scale_x, scale_y);
+};
+
+void resize_area(input_window_uint8* input, const int scale_x, const int scale_y, output_window_uint8* output) {
+    xf::cv::aie::resize_area_rgba<RESIZE_AREA_MAX_WIDTH_IN, RESIZE_AREA_MAX_ROWS_IN>(input, output, scale_x, scale_y);
+};
+
+void resize_bicubic(input_window_uint8* input, const int scale_x, const int scale_y, output_window_uint8* output) {
+    xf::cv::aie::resize_bicubic_rgba<RESIZE_CUBIC_MAX_WIDTH_IN>(input, output, scale_x, scale_y);
+};
+
+/*
+Letterbox resize for DNN inputs: pad bands, normalization and the HWC to CHW
+transpose are done while resizing, the geometry comes in as runtime
+parameters (see LetterboxParam and letterboxParams).
+*/
+
+void resize_letterbox(input_window_uint8* input,
+                      const int scale_x,
+                      const int scale_y,
+                      const int16_t (&params)[LETTERBOX_PARAMS],
+                      output_window_int8* output_r,
+                      output_window_int8* output_g,
+                      output_window_int8* output_b) {
+    xf::cv::aie::resize_letterbox_chw(input, output_r, output_g, output_b, scale_x, scale_y,
+                                      params[LETTERBOX_NET_W], params[LETTERBOX_PAD_LEFT], params[LETTERBOX_CONTENT_W],
+                                      params[LETTERBOX_PAD_VALUE], &params[LETTERBOX_MEAN], &params[LETTERBOX_ALPHA]);
+};
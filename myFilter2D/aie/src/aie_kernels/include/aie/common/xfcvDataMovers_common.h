@@ -101,11 +101,40 @@ void deviceInit(const char* xclBin) {
 struct xfcvDataMoverParams {
     cv::Size mInputImgSize;
     cv::Size mOutputImgSize;
+    // Resize tiler: source rows per output row, 0 keeps the two rows of the
+    // library tiler (see resizeFootprintMetaData)
+    int mResizeRows;
 
-    xfcvDataMoverParams() : mInputImgSize(0, 0), mOutputImgSize(0, 0) {}
+    xfcvDataMoverParams() : mInputImgSize(0, 0), mOutputImgSize(0, 0), mResizeRows(0) {}
 
-    xfcvDataMoverParams(const cv::Size& inImgSize) : mInputImgSize(inImgSize), mOutputImgSize(inImgSize) {}
+    xfcvDataMoverParams(const cv::Size& inImgSize)
+        : mInputImgSize(inImgSize), mOutputImgSize(inImgSize), mResizeRows(0) {}
 
-    xfcvDataMoverParams(const cv::Size& inImgSize, const cv::Size& outImgSize)
-        : mInputImgSize(inImgSize), mOutputImgSize(outImgSize) {}
+    xfcvDataMoverParams(const cv::Size& inImgSize, const cv::Size& outImgSize, int resizeRows = 0)
+        : mInputImgSize(inImgSize), mOutputImgSize(outImgSize), mResizeRows(resizeRows) {}
 };
+
+// Resize tiler metadata for kernels that read more than two source rows per
+// output row: tile o holds 'rows' full width source rows starting at
+// floor((o + 0.5) * scale_y + 0.5 - rows / 2), with scale_y in Q16 as
+// resizeScaleQ16 computes it, clamped into the image. rows = 4 gives the
+// bicubic taps, ceil(scale_y) + 1 covers the area footprint of the row.
+inline void resizeFootprintMetaData(const cv::Size& inImgSize,
+                                    const cv::Size& outImgSize,
+                                    int rows,
+                                    std::vector<smartTileMetaData>& metaDataList,
+                                    uint16_t& numberOfTileRows,
+                                    uint16_t& numberOfTileColumns) {
+    const int64_t scaleY = (((int64_t)inImgSize.height << 16) + outImgSize.height / 2) / outImgSize.height;
+    rows = std::min(rows, inImgSize.height);
+
+    metaDataList.clear();
+    for (int o = 0; o < outImgSize.height; o++) {
+        const int64_t start = o * scaleY + scaleY / 2 + (1 << 15) - (int64_t)rows * (1 << 15);
+        const int positionV = std::min(std::max((int)(start >> 16), 0), inImgSize.height - rows);
+        metaDataList.emplace_back(o, rows, inImgSize.width, positionV, 0, o, 0, 0, 0, 0, 0, outImgSize.height,
+                                  outImgSize.width, outImgSize.height, 1, true);
+    }
+    numberOfTileRows = outImgSize.height;
+    numberOfTileColumns = 1;
+}
@@ -323,7 +323,7 @@ class xfcvDataMovers<KIND, DATA_TYPE, TILE_HEIGHT_MAX, TILE_WIDTH_MAX, AIE_VECTO
     }
     //}
 
-    void compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize = cv::Size(0, 0));
+    void compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize = cv::Size(0, 0), int resizeRows = 0);
 
     // These functions will start the data transfer protocol {
     template <DataMoverKind _t = KIND, typename std::enable_if<(_t == TILER)>::type* = nullptr>
@@ -348,7 +348,7 @@ class xfcvDataMovers<KIND, DATA_TYPE, TILE_HEIGHT_MAX, TILE_WIDTH_MAX, AIE_VECTO
         } else {
             mpImgData = (DATA_TYPE*)img_data;
             mImageSize = {(uint16_t)img_size.height, (uint16_t)img_size.width, (uint16_t)sizeof(DATA_TYPE) * mchannels};
-            // compute_metadata(img_size, params.mOutputImgSize);
+            compute_metadata(img_size, params.mOutputImgSize, params.mResizeRows);
         }
 
         int new_img_buffer_size = imgSize();
@@ -470,6 +470,15 @@ class xfcvDataMovers<KIND, DATA_TYPE, TILE_HEIGHT_MAX, TILE_WIDTH_MAX, AIE_VECTO
     }
 
     //}
+
+    // Input tile origins {PosH, PosV} in tile order, as the kernels read them
+    // with xfGetTilePosH / xfGetTilePosV (valid once the image was sent)
+    template <DataMoverKind _t = KIND, typename std::enable_if<(_t == TILER)>::type* = nullptr>
+    std::vector<std::array<int, 2> > tileOrigins() const {
+        std::vector<std::array<int, 2> > origins;
+        for (const auto& metaData : mMetaDataList) origins.push_back({metaData.positionH(), metaData.positionV()});
+        return origins;
+    }
 };
 
 /*
@@ -490,7 +499,7 @@ template <DataMoverKind KIND,
           int AIE_VECTORIZATION_FACTOR,
           int CORES>
 void xfcvDataMovers<KIND, DATA_TYPE, TILE_HEIGHT_MAX, TILE_WIDTH_MAX, AIE_VECTORIZATION_FACTOR, CORES, 0, true>::
-    compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize) {
+    compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize, int resizeRows) {
     mMetaDataList.clear();
 
     cv::Size inputImgSize = inImgSize;
@@ -512,9 +521,14 @@ void xfcvDataMovers<KIND, DATA_TYPE, TILE_HEIGHT_MAX, TILE_WIDTH_MAX, AIE_VECTOR
         mIsOutputResize = false;
         mOutSize = cv::Size(inputImgSize.height, inputImgSize.width);
     } else {
-        smartTileTilerGenerateMetaDataWithSpecifiedTileSize({inputImgSize.height, inputImgSize.width},
-                                                            {outputImgSize.height, outputImgSize.width}, mMetaDataList,
-                                                            mTileRows, mTileCols, AIE_VECTORIZATION_FACTOR, true);
+        if (resizeRows > 0) {
+            resizeFootprintMetaData(inputImgSize, outputImgSize, resizeRows, mMetaDataList, mTileRows, mTileCols);
+        } else {
+            smartTileTilerGenerateMetaDataWithSpecifiedTileSize({inputImgSize.height, inputImgSize.width},
+                                                                {outputImgSize.height, outputImgSize.width},
+                                                                mMetaDataList, mTileRows, mTileCols,
+                                                                AIE_VECTORIZATION_FACTOR, true);
+        }
         mIsOutputResize = true;
         mOutSize = cv::Size(outputImgSize.height, outputImgSize.width);
         std::cout << outputImgSize.height << " " << outputImgSize.width << std::endl;
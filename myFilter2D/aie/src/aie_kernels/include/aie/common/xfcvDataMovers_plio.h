@@ -319,7 +319,7 @@ class xfcvDataMovers {
     }
     //}
 
-    void compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize = cv::Size(0, 0));
+    void compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize = cv::Size(0, 0), int resizeRows = 0);
 
     // These functions will start the data transfer protocol {
     template <DataMoverKind _t = KIND, typename std::enable_if<(_t == TILER)>::type* = nullptr>
@@ -341,11 +341,11 @@ class xfcvDataMovers {
                 // Pack metadata
                 compute_metadata(img.size());
             }
-        } /* else {
-             mpImage = &img;
-             mImageSize = {(uint16_t)img.rows, (uint16_t)img.cols, (uint16_t)img.elemSize()};
-             compute_metadata(img.size(), params.mOutputImgSize);
-         }*/
+        } else {
+            mpImage = &img;
+            mImageSize = {(uint16_t)img.rows, (uint16_t)img.cols, (uint16_t)img.elemSize()};
+            compute_metadata(img.size(), params.mOutputImgSize, params.mResizeRows);
+        }
 
         auto new_metadata_buffer_size = metadataSize();
         int new_img_buffer_size = imgSize();
@@ -486,6 +486,15 @@ class xfcvDataMovers {
 
         return tileRowsPerCore(core) * tileColsPerCore(core);
     }
+
+    // Input tile origins {PosH, PosV} in tile order, as the kernels read them
+    // with xfGetTilePosH / xfGetTilePosV (valid once the image was sent)
+    template <DataMoverKind _t = KIND, typename std::enable_if<(_t == TILER)>::type* = nullptr>
+    std::vector<std::array<int, 2> > tileOrigins() const {
+        std::vector<std::array<int, 2> > origins;
+        for (const auto& metaData : mMetaDataList) origins.push_back({metaData.positionH(), metaData.positionV()});
+        return origins;
+    }
 };
 
 template <DataMoverKind KIND,
@@ -503,7 +512,7 @@ void xfcvDataMovers<KIND,
                     AIE_VECTORIZATION_FACTOR,
                     CORES,
                     PL_AXI_BITWIDTH,
-                    USE_GMIO>::compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize) {
+                    USE_GMIO>::compute_metadata(const cv::Size& inImgSize, const cv::Size& outImgSize, int resizeRows) {
     mMetaDataList.clear();
     mMetaDataVec.clear();
 
@@ -524,6 +533,9 @@ void xfcvDataMovers<KIND,
                                                             mTileRows, mTileCols, {TILE_HEIGHT_MAX, TILE_WIDTH_MAX},
                                                             {mOverlapH, mOverlapH}, {mOverlapV, mOverlapV},
                                                             AIE_VECTORIZATION_FACTOR, true);
+    } else if (resizeRows > 0) {
+        isOutputResize = true;
+        resizeFootprintMetaData(inputImgSize, outputImgSize, resizeRows, mMetaDataList, mTileRows, mTileCols);
     } else {
         isOutputResize = true;
         smartTileTilerGenerateMetaDataWithSpecifiedTileSize({inputImgSize.height, inputImgSize.width},
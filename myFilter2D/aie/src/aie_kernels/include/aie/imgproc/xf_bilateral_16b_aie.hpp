@@ -0,0 +1,169 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_filter2d_16b_aie.hpp"
+#include "xf_filter_const.hpp"
+
+#ifndef _AIE_BILATERAL_16B_H_
+#define _AIE_BILATERAL_16B_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Fractional bits kept on the weighted sum before normalization
+static constexpr int BILATERAL_NUM_FRAC_BITS = 3;
+// recip[den] = round((1 << (BILATERAL_WEIGHT_BITS + BILATERAL_RECIP_BITS)) / den)
+static constexpr int BILATERAL_RECIP_BITS = 11;
+
+// Range weights exp(-d^2 / (2 * 16^2)) in Q15 for d = 0 .. 62 LUT steps,
+// the last entry catches every larger difference and gives it no weight
+static constexpr int BILATERAL_RANGE_LUT_SIZE = 64;
+alignas(32) static const int16_t BILATERAL_RANGE_LUT[BILATERAL_RANGE_LUT_SIZE] = {
+    32767, 32703, 32512, 32196, 31759, 31205, 30542, 29776, 28917, 27972, 26953, 25870, 24734, 23555, 22345, 21115,
+    19874, 18634, 17402, 16189, 15002, 13847, 12732, 11661, 10638, 9667,  8750,  7890,  7086,  6340,  5650,  5015,
+    4435,  3906,  3427,  2995,  2607,  2261,  1952,  1680,  1440,  1229,  1045,  885,   747,   628,   526,   438,
+    364,   301,   248,   204,   167,   136,   110,   89,    72,    57,    46,    37,    29,    23,    18,    0};
+
+// Positions of the 9 taps in the filter2D_k3_border coefficient layout
+static constexpr int BILATERAL_K3_TAPS[9] = {0, 1, 3, 5, 6, 8, 10, 11, 13};
+
+// Per lane table lookup, AIE1 has no vector gather
+template <int N>
+inline ::aie::vector<int16_t, PARALLEL_FACTOR_16b> bilateral_lookup(
+    const int16_t (&table)[N], const ::aie::vector<int16_t, PARALLEL_FACTOR_16b>& idx) {
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> v;
+    for (int l = 0; l < PARALLEL_FACTOR_16b; l++) chess_unroll_loop(*) { v[l] = table[idx[l]]; }
+    return v;
+}
+
+template <bool LEFT, bool RIGHT>
+inline v16int16 bilateral_k3_block(const int16* const* row,
+                                   const int j,
+                                   const int16_t image_width,
+                                   const int16_t (&ws)[9],
+                                   const int range_shift,
+                                   const int16_t (&recip)[(1 << BILATERAL_WEIGHT_BITS) + 1]) {
+    ::aie::vector<int16_t, 32> d[3];
+    for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+            d[r] = filter2D_load_row_border<LEFT, RIGHT>(row[r], j, image_width);
+        }
+
+    const ::aie::vector<int16_t, PARALLEL_FACTOR_16b> centre = filter2D_tap(d[1], 0);
+    const ::aie::vector<int16_t, PARALLEL_FACTOR_16b> last_idx =
+        ::aie::broadcast<int16_t, PARALLEL_FACTOR_16b>(BILATERAL_RANGE_LUT_SIZE - 1);
+    const ::aie::vector<int16_t, PARALLEL_FACTOR_16b> one = ::aie::broadcast<int16_t, PARALLEL_FACTOR_16b>(1);
+
+    // The centre pixel always has full range weight, num starts at the rounding bias
+    ::aie::accum<acc48, PARALLEL_FACTOR_16b> num;
+    num.from_vector(one, BILATERAL_WEIGHT_BITS - BILATERAL_NUM_FRAC_BITS - 1);
+    num = ::aie::mac(num, centre, ws[4]);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> den = ::aie::broadcast<int16_t, PARALLEL_FACTOR_16b>(ws[4]);
+
+    for (int n = 0; n < 9; n++) chess_unroll_loop(*) {
+            if (n == 4) continue;
+            ::aie::vector<int16_t, PARALLEL_FACTOR_16b> p = filter2D_tap(d[n / 3], n % 3 - 1);
+            ::aie::vector<int16_t, PARALLEL_FACTOR_16b> idx =
+                ::aie::min(::aie::downshift(::aie::abs(::aie::sub(p, centre)), range_shift), last_idx);
+            ::aie::vector<int16_t, PARALLEL_FACTOR_16b> w =
+                ::aie::mul(bilateral_lookup(BILATERAL_RANGE_LUT, idx), ws[n]).template to_vector<int16_t>(15);
+            num = ::aie::mac(num, p, w);
+            den = ::aie::add(den, w);
+        }
+
+    // out = num / den, through the reciprocal table
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> q =
+        num.template to_vector<int16_t>(BILATERAL_WEIGHT_BITS - BILATERAL_NUM_FRAC_BITS);
+    ::aie::accum<acc48, PARALLEL_FACTOR_16b> out;
+    out.from_vector(one, BILATERAL_NUM_FRAC_BITS + BILATERAL_RECIP_BITS - 1);
+    out = ::aie::mac(out, q, bilateral_lookup(recip, den));
+    return out.template to_vector<int16_t>(BILATERAL_NUM_FRAC_BITS + BILATERAL_RECIP_BITS);
+}
+
+/**
+ * 16-bit bilateral filter (3x3) with border effect handling
+ *
+ * Each neighbour is weighted by its spatial weight from the coefficient
+ * table times a range weight looked up in BILATERAL_RANGE_LUT with
+ * |p - centre| >> range_shift, so every step of range_shift doubles the
+ * range sigma (16 intensity levels at 0). The weighted sum is normalized
+ * with a reciprocal table built on the first call, results are within
+ * one level of the exact quotient. The spatial weights use the
+ * filter2D_k3_border layout and must sum to 1 << BILATERAL_WEIGHT_BITS with
+ * a centre weight of at least BILATERAL_MIN_CENTRE_WEIGHT, as
+ * bilateralCoeffK3 produces them. Input values are limited to 12 bits by the
+ * normalization headroom. Borders are replicated, tiles need an overlap of 1
+ * and metadata is copied to the output tile.
+ */
+__attribute__((noinline)) void bilateral_k3_border(input_window_int16* img_in,
+                                                   const int16_t (&coeff)[16],
+                                                   output_window_int16* img_out,
+                                                   const int range_shift) {
+    static int16_t recip[(1 << BILATERAL_WEIGHT_BITS) + 1];
+    static bool recip_init = false;
+    if (!recip_init) {
+        recip[0] = 0;
+        for (int den = 1; den <= (1 << BILATERAL_WEIGHT_BITS); den++) {
+            const int r = ((1 << (BILATERAL_WEIGHT_BITS + BILATERAL_RECIP_BITS)) + den / 2) / den;
+            recip[den] = (int16_t)std::min(r, 32767);
+        }
+        recip_init = true;
+    }
+
+    int16_t ws[9];
+    for (int n = 0; n < 9; n++) chess_unroll_loop(*) { ws[n] = coeff[BILATERAL_K3_TAPS[n]]; }
+
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    for (int i = 0; i < image_height; i++) {
+        const int16* row[3];
+        for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+                row[r] = ptr_img_buffer + std::min(std::max(i + r - 1, 0), image_height - 1) * stride;
+            }
+
+        // Left border
+        *(ptr_out++) = bilateral_k3_block<true, false>(row, 0, image_width, ws, range_shift, recip);
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                *(ptr_out++) = bilateral_k3_block<false, false>(row, j, image_width, ws, range_shift, recip);
+            }
+
+        // Right border
+        *(ptr_out++) = bilateral_k3_block<false, true>(row, 0, image_width, ws, range_shift, recip);
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
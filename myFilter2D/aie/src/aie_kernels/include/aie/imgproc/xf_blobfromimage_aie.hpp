@@ -15,20 +15,12 @@
  */
 
 #include <adf.h>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
 
 #ifndef _AIE_BLOBFROMIAMGE_H_
 #define _AIE_BLOBFROMIAMGE_H_
 
-#define img_height 32
-#define img_width 128
-
-/*#define alpha   0.342
-#define beta    0.0039215686274509803921568627451
-#define gama    5.2432
-
-#define threshold1 -127
-#define threshold2 127*/
-
 /**
  * ----------------------------------------------------------------------------
  * floating point blobFromImage
@@ -40,14 +32,14 @@ namespace aie {
 
 enum ops { mean_sub, scale_n_clip, clip, scale_n_bias, scale_n_bias_mean_sub, fused_op };
 
-void mean_subtraction(v8float* restrict ptr_in, v8float* restrict ptr_out, float alpha) {
+void mean_subtraction(v8float* restrict ptr_in, v8float* restrict ptr_out, const int n, float alpha) {
     v8float data_buf1 = null_v8float();
     v8float chess_storage(WR2) alpha_acc = null_v8float();
     v8float chess_storage(WD0) data_out = null_v8float();
     for (int i = 0; i < 8; i++) {
         alpha_acc = upd_elem(alpha_acc, i, alpha);
     }
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
+    for (int j = 0; j < n; j += 8) // 8x samples per loop
         chess_prepare_for_pipelining chess_loop_range(14, ) {
             data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
             data_out = fpsub(data_buf1, concat(alpha_acc, undef_v8float()), 0, 0x76543210);
@@ -55,7 +47,7 @@ void mean_subtraction(v8float* restrict ptr_in, v8float* restrict ptr_out, float
         }
 }
 
-void clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, int th1, int th2) {
+void clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, const int n, int th1, int th2) {
     v8float data_buf1 = null_v8float();
     v8float chess_storage(WR2) thresh1_acc = null_v8float();
     v8float chess_storage(WR3) thresh2_acc = null_v8float();
@@ -67,7 +59,7 @@ void clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, int th1, int
         thresh1_acc = upd_elem(thresh1_acc, i, th1);
         thresh2_acc = upd_elem(thresh2_acc, i, th2);
     }
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
+    for (int j = 0; j < n; j += 8) // 8x samples per loop
         chess_prepare_for_pipelining chess_loop_range(14, ) {
             data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
             temp_out = fpmax(thresh1_acc, concat(data_buf1, undef_v8float()), 0, 0x76543210);
@@ -75,7 +67,7 @@ void clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, int th1, int
             *(ptr_out++) = (v8float)data_out;
         }
 }
-void scale_n_bias_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, float beta, float gama) {
+void scale_n_bias_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, const int n, float beta, float gama) {
     v8float data_buf1 = null_v8float();
     v8float bias_acc = null_v8float();
     v8float scale = null_v8float();
@@ -86,7 +78,7 @@ void scale_n_bias_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, float
         scale = upd_elem(scale, i, beta);
         bias_acc = upd_elem(bias_acc, i, gama);
     }
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
+    for (int j = 0; j < n; j += 8) // 8x samples per loop
         chess_prepare_for_pipelining chess_loop_range(14, ) {
             data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
             data_out = fpmac(bias_acc, concat(data_buf1, undef_v8float()), 0, 0x76543210, scale, 0, 0x76543210);
@@ -94,7 +86,7 @@ void scale_n_bias_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, float
         }
 }
 
-void scale_n_clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, float beta, int th1, int th2) {
+void scale_n_clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, const int n, float beta, int th1, int th2) {
     v8float data_buf1 = null_v8float();
     v8float scale = null_v8float();
     v8float bias_acc = null_v8float();
@@ -105,33 +97,23 @@ void scale_n_clip_fun(v8float* restrict ptr_in, v8float* restrict ptr_out, float
     v8float chess_storage(WD0) temp_out = null_v8float();
     v8float chess_storage(WD1) data_out = null_v8float();
 
-    v8float* restrict ptr_out_temp = ptr_out;
-
     for (int i = 0; i < 8; i++) {
         scale = upd_elem(scale, i, beta);
         thresh1_acc = upd_elem(thresh1_acc, i, th1);
         thresh2_acc = upd_elem(thresh2_acc, i, th2);
     }
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
+    // scale and clip in one pass, no intermediate round trip through ptr_out
+    for (int j = 0; j < n; j += 8) // 8x samples per loop
         chess_prepare_for_pipelining chess_loop_range(14, ) {
             data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
             temp_out = fpmac(bias_acc, concat(data_buf1, undef_v8float()), 0, 0x76543210, scale, 0, 0x76543210);
-            *(ptr_out_temp++) = (v8float)data_out;
-        }
-
-    ptr_out_temp = ptr_out_temp - ((img_height * img_width) / 8);
-
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
-        chess_prepare_for_pipelining chess_loop_range(14, ) {
-            data_buf1 = *(ptr_out_temp++); // in:00++8|_________|_________|_________
-
-            temp_out = fpmax(thresh1_acc, concat(data_buf1, undef_v8float()), 0, 0x76543210);
+            temp_out = fpmax(thresh1_acc, concat(temp_out, undef_v8float()), 0, 0x76543210);
             data_out = fpmin(thresh2_acc, concat(temp_out, undef_v8float()), 0, 0x76543210);
             *(ptr_out++) = (v8float)data_out;
         }
 }
 void scale_n_bias_mean_sub_fun(
-    v8float* restrict ptr_in, v8float* restrict ptr_out, float alpha, float beta, float gama) {
+    v8float* restrict ptr_in, v8float* restrict ptr_out, const int n, float alpha, float beta, float gama) {
     v8float chess_storage(WR2) data_buf1 = null_v8float();
     v8float chess_storage(WR3) bias_acc = null_v8float();
     v8float scale = null_v8float();
@@ -145,7 +127,7 @@ void scale_n_bias_mean_sub_fun(
         scale = upd_elem(scale, i, beta);
         bias_acc = upd_elem(bias_acc, i, gama);
     }
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
+    for (int j = 0; j < n; j += 8) // 8x samples per loop
         chess_prepare_for_pipelining chess_loop_range(14, ) {
             data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
             temp_out = fpsub(data_buf1, concat(alpha_acc, undef_v8float()), 0, 0);
@@ -153,16 +135,21 @@ void scale_n_bias_mean_sub_fun(
             *(ptr_out++) = (v8float)data_out;
         }
 }
-void fused_op_fun(
-    v8float* restrict ptr_in, v8float* restrict ptr_out, float alpha, float beta, float gama, int th1, int th2) {
-    v8float* restrict ptr_out_temp = ptr_out;
-
+void fused_op_fun(v8float* restrict ptr_in,
+                  v8float* restrict ptr_out,
+                  const int n,
+                  float alpha,
+                  float beta,
+                  float gama,
+                  int th1,
+                  int th2) {
     v8float chess_storage(WR2) data_buf1 = null_v8float();
-    v8float data_buf = null_v8float();
 
     v8float bias_acc = null_v8float();
     v8float scale = null_v8float();
     v8float alpha_acc = null_v8float();
+    v8float thresh1_acc = null_v8float();
+    v8float thresh2_acc = null_v8float();
 
     v8float chess_storage(WD0) temp_out = null_v8float();
     v8float chess_storage(WD1) data_out = null_v8float();
@@ -171,75 +158,122 @@ void fused_op_fun(
         alpha_acc = upd_elem(alpha_acc, i, alpha);
         bias_acc = upd_elem(bias_acc, i, gama);
         scale = upd_elem(scale, i, beta);
-    }
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
-        chess_prepare_for_pipelining chess_loop_range(14, ) {
-            data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
-
-            temp_out = fpsub(data_buf1, concat(alpha_acc, undef_v8float()), 0, 0);
-            data_out = fpmac(bias_acc, concat(temp_out, undef_v8float()), 0, 0x76543210, scale, 0, 0x76543210);
-            *(ptr_out_temp++) = (v8float)data_out;
-        }
-
-    ptr_out_temp = ptr_out_temp - ((img_height * img_width) / 8);
-
-    v8float chess_storage(WR2) thresh1_acc = null_v8float();
-    v8float chess_storage(WR3) thresh2_acc = null_v8float();
-    for (int i = 0; i < 8; i++) {
         thresh1_acc = upd_elem(thresh1_acc, i, th1);
         thresh2_acc = upd_elem(thresh2_acc, i, th2);
     }
-
-    for (int j = 0; j < (img_height * img_width); j += 8) // 8x samples per loop
+    // mean, scale, bias and clip in one pass
+    for (int j = 0; j < n; j += 8) // 8x samples per loop
         chess_prepare_for_pipelining chess_loop_range(14, ) {
-            data_buf = *(ptr_out_temp++); // in:00++8|_________|_________|_________
+            data_buf1 = *(ptr_in++); // in:00++8|_________|_________|_________
 
-            temp_out = fpmax(thresh1_acc, concat(data_buf, undef_v8float()), 0, 0x76543210);
+            temp_out = fpsub(data_buf1, concat(alpha_acc, undef_v8float()), 0, 0);
+            temp_out = fpmac(bias_acc, concat(temp_out, undef_v8float()), 0, 0x76543210, scale, 0, 0x76543210);
+            temp_out = fpmax(thresh1_acc, concat(temp_out, undef_v8float()), 0, 0x76543210);
             data_out = fpmin(thresh2_acc, concat(temp_out, undef_v8float()), 0, 0x76543210);
-
             *(ptr_out++) = (v8float)data_out;
         }
 }
 
-// void blobFromImage( input_window_float * img_in, output_window_float * restrict img_out,float alpha, float beta,
-// float gama,int threshold1,int threshold2)
-void blobFromImage_api(input_window_float* img_in, output_window_float* img_out)
-// void blobFromImage( input_window_float * img_in, output_window_float * img_out)
-{
-    float alpha = 0.342;
-    float beta = 0.0039215686274509803921568627451;
-    float gama = 5.2432;
-    int threshold1 = -127;
-    int threshold2 = 127;
+/**
+ * blobFromImage on float tiles, the op (enum ops) and its constants are
+ * runtime parameters and the tile geometry comes from the metadata, so one
+ * kernel serves every model's normalization:
+ * mean_sub              : x - alpha
+ * scale_n_clip          : clip(x * beta)
+ * clip                  : clip(x)
+ * scale_n_bias          : x * beta + gama
+ * scale_n_bias_mean_sub : (x - alpha) * beta + gama
+ * fused_op              : clip((x - alpha) * beta + gama)
+ * with clip to [threshold1, threshold2]. Tiles hold a multiple of 8 pixels.
+ */
+void blobFromImage_api(input_window_float* img_in,
+                       output_window_float* img_out,
+                       const int op,
+                       const float alpha,
+                       const float beta,
+                       const float gama,
+                       const int threshold1,
+                       const int threshold2) {
+    float* img_in_ptr = (float*)img_in->ptr;
+    float* img_out_ptr = (float*)img_out->ptr;
+
+    const int n = xfGetTileWidth(img_in_ptr) * xfGetTileHeight(img_in_ptr);
 
-    v8float* restrict ptr_img_buffer = (v8float*)img_in->ptr;
-    v8float* restrict ptr_out_buffer = (v8float*)img_out->ptr;
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
 
-    v8float* restrict ptr_in = (v8float*)ptr_img_buffer;
-    v8float* restrict ptr_out = (v8float*)ptr_out_buffer;
+    v8float* restrict ptr_in = (v8float*)xfGetImgDataPtr(img_in_ptr);
+    v8float* restrict ptr_out = (v8float*)xfGetImgDataPtr(img_out_ptr);
 
-    switch (OPMODE) {
+    switch (op) {
         case mean_sub:
-            mean_subtraction(ptr_in, ptr_out, alpha);
+            mean_subtraction(ptr_in, ptr_out, n, alpha);
             break;
         case scale_n_clip:
-            scale_n_clip_fun(ptr_in, ptr_out, beta, threshold1, threshold2);
+            scale_n_clip_fun(ptr_in, ptr_out, n, beta, threshold1, threshold2);
             break;
         case clip:
-            clip_fun(ptr_in, ptr_out, threshold1, threshold2);
+            clip_fun(ptr_in, ptr_out, n, threshold1, threshold2);
             break;
         case scale_n_bias:
-            scale_n_bias_fun(ptr_in, ptr_out, beta, gama);
+            scale_n_bias_fun(ptr_in, ptr_out, n, beta, gama);
             break;
         case scale_n_bias_mean_sub:
-            scale_n_bias_mean_sub_fun(ptr_in, ptr_out, alpha, beta, gama);
+            scale_n_bias_mean_sub_fun(ptr_in, ptr_out, n, alpha, beta, gama);
             break;
         case fused_op:
-            fused_op_fun(ptr_in, ptr_out, alpha, beta, gama, threshold1, threshold2);
+            fused_op_fun(ptr_in, ptr_out, n, alpha, beta, gama, threshold1, threshold2);
             break;
     }
 }
 
+/**
+ * ----------------------------------------------------------------------------
+ * int8 quantized blobFromImage
+ * ----------------------------------------------------------------------------
+ * Every op above is an affine map followed by an optional clip, so for an
+ * int8 output with quantization scale qs the host folds op, constants and qs
+ * into y = clip((x * scale + bias) >> shift, lo, hi) (blobQuantParams), and
+ * the kernel maps uint8 pixels straight to int8, 16 per iteration, without
+ * the float conversion or the 4x larger float tiles.
+ * Tiles hold a multiple of 16 pixels.
+ */
+__attribute__((noinline)) void blobFromImage_int8(input_window_uint8* img_in,
+                                                  output_window_int8* img_out,
+                                                  const int scale,
+                                                  const int bias,
+                                                  const int shift,
+                                                  const int lo,
+                                                  const int hi) {
+    uint8_t* img_in_ptr = (uint8_t*)img_in->ptr;
+    int8_t* img_out_ptr = (int8_t*)img_out->ptr;
+
+    const int n = xfGetTileWidth(img_in_ptr) * xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+    xfSignedSaturation(img_out_ptr);
+
+    uint8_t* restrict ptr_in = (uint8_t*)xfGetImgDataPtr(img_in_ptr);
+    int8_t* restrict ptr_out = (int8_t*)xfGetImgDataPtr(img_out_ptr);
+
+    // bias carries the rounding of the final shift
+    ::aie::accum<acc48, 16> acc_bias;
+    acc_bias.from_vector(::aie::broadcast<int32_t, 16>(bias), 0);
+
+    // Small out_scale values take y beyond int16, saturate before the clamp
+    set_sat();
+    for (int j = 0; j < n; j += 16) // 16x samples per loop
+        chess_prepare_for_pipelining chess_loop_range(1, ) {
+            ::aie::vector<int16_t, 16> x = ::aie::load_v<16>(ptr_in).unpack().template cast_to<int16_t>();
+            ::aie::accum<acc48, 16> acc = ::aie::mac(acc_bias, x, (int16_t)scale);
+            ::aie::vector<int16_t, 16> y = acc.template to_vector<int16_t>(shift);
+            y = ::aie::max(::aie::min(y, (int16_t)hi), (int16_t)lo);
+            ::aie::store_v(ptr_out, y.pack());
+            ptr_in += 16;
+            ptr_out += 16;
+        }
+    clr_sat();
+}
+
 } // aie
 } // cv
 } // xf
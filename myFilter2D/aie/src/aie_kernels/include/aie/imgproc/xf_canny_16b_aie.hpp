@@ -0,0 +1,190 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_sobel_16b_aie.hpp"
+
+#ifndef _AIE_CANNY_16B_H_
+#define _AIE_CANNY_16B_H_
+
+#define CANNY_TAN22_Q8 106 // tan(22.5) in Q8
+#define CANNY_TAN67_Q8 618 // tan(67.5) in Q8
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+/**
+ * Packs the L1 gradient magnitude and the quantized gradient direction into
+ * one 16-bit pixel: (|dx| + |dy|) << 2 | sector
+ *
+ *   sector 0 : horizontal gradient (|dy| <= tan(22.5) * |dx|)
+ *   sector 1 : 45 degrees, dx and dy of equal sign
+ *   sector 2 : vertical gradient (|dy| >= tan(67.5) * |dx|)
+ *   sector 3 : 135 degrees, dx and dy of opposite sign
+ *
+ * The magnitude must fit into 13 bits, which holds for 8-bit pixel data.
+ */
+inline v16int16 canny_pack_gradient(v16acc48 gx, v16acc48 gy) {
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> dx = srs(gx, 0);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> dy = srs(gy, 0);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> adx = ::aie::abs(dx);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> ady = ::aie::abs(dy);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> mag = ::aie::add(adx, ady);
+
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> t22 =
+        ::aie::mul(adx, (int16_t)CANNY_TAN22_Q8).template to_vector<int16_t>(8);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> t67 =
+        ::aie::mul(adx, (int16_t)CANNY_TAN67_Q8).template to_vector<int16_t>(8);
+
+    ::aie::mask<PARALLEL_FACTOR_16b> same_sign = ::aie::ge(::aie::bit_xor(dx, dy), (int16_t)0);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> sector = ::aie::broadcast<int16_t, PARALLEL_FACTOR_16b>(3);
+    sector = ::aie::select(sector, ::aie::broadcast<int16_t, PARALLEL_FACTOR_16b>(1), same_sign);
+    sector = ::aie::select(sector, ::aie::broadcast<int16_t, PARALLEL_FACTOR_16b>(2), ::aie::ge(ady, t67));
+    sector = ::aie::select(sector, ::aie::zeros<int16_t, PARALLEL_FACTOR_16b>(), ::aie::ge(t22, ady));
+
+    return ::aie::bit_or(::aie::upshift(mag, 2), sector);
+}
+
+/**
+ * 16-bit Canny gradient (3x3 Sobel) with border effect handling, writes the
+ * packed magnitude / direction tile consumed by canny_nms_k3_border.
+ */
+__attribute__((noinline)) void canny_gradient_k3_border(input_window_int16* img_in, output_window_int16* img_out) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    v16int16 kx[2];
+    v16int16 ky[2];
+    sobel_k3_coeff(1, 2, kx, ky);
+
+    v16acc48 gx;
+    v16acc48 gy;
+
+    for (int i = 0; i < image_height; i++) {
+        const int16* restrict row0 = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        const int16* restrict row1 = ptr_img_buffer + i * stride;
+        const int16* restrict row2 = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+
+        // Left border
+        sobel_k3_block<true, false>(row0, row1, row2, 0, image_width, kx, ky, gx, gy);
+        *(ptr_out++) = canny_pack_gradient(gx, gy);
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                sobel_k3_block<false, false>(row0, row1, row2, j, image_width, kx, ky, gx, gy);
+                *(ptr_out++) = canny_pack_gradient(gx, gy);
+            }
+
+        // Right border
+        sobel_k3_block<false, true>(row0, row1, row2, 0, image_width, kx, ky, gx, gy);
+        *(ptr_out++) = canny_pack_gradient(gx, gy);
+    }
+}
+
+template <bool LEFT, bool RIGHT>
+inline v16int16 canny_nms_block(const int16* restrict row0,
+                                const int16* restrict row1,
+                                const int16* restrict row2,
+                                const int j,
+                                const int16_t image_width) {
+    ::aie::vector<int16_t, 32> p0 = filter2D_load_row_border<LEFT, RIGHT>(row0, j, image_width);
+    ::aie::vector<int16_t, 32> p1 = filter2D_load_row_border<LEFT, RIGHT>(row1, j, image_width);
+    ::aie::vector<int16_t, 32> p2 = filter2D_load_row_border<LEFT, RIGHT>(row2, j, image_width);
+    ::aie::vector<int16_t, 32> m0 = ::aie::downshift(p0, 2);
+    ::aie::vector<int16_t, 32> m1 = ::aie::downshift(p1, 2);
+    ::aie::vector<int16_t, 32> m2 = ::aie::downshift(p2, 2);
+
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> sector = ::aie::bit_and((int16_t)3, filter2D_tap(p1, 0));
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> mag = filter2D_tap(m1, 0);
+
+    // Neighbours along the gradient direction
+    ::aie::mask<PARALLEL_FACTOR_16b> s1 = ::aie::eq(sector, (int16_t)1);
+    ::aie::mask<PARALLEL_FACTOR_16b> s2 = ::aie::eq(sector, (int16_t)2);
+    ::aie::mask<PARALLEL_FACTOR_16b> s3 = ::aie::eq(sector, (int16_t)3);
+
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> n1 = filter2D_tap(m1, -1); // sector 0: left
+    n1 = ::aie::select(n1, filter2D_tap(m0, -1), s1);                       // sector 1: top left
+    n1 = ::aie::select(n1, filter2D_tap(m0, 0), s2);                        // sector 2: top
+    n1 = ::aie::select(n1, filter2D_tap(m0, 1), s3);                        // sector 3: top right
+
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> n2 = filter2D_tap(m1, 1); // sector 0: right
+    n2 = ::aie::select(n2, filter2D_tap(m2, 1), s1);                       // sector 1: bottom right
+    n2 = ::aie::select(n2, filter2D_tap(m2, 0), s2);                       // sector 2: bottom
+    n2 = ::aie::select(n2, filter2D_tap(m2, -1), s3);                      // sector 3: bottom left
+
+    // Keep local maxima, ties are broken towards the first neighbour
+    ::aie::mask<PARALLEL_FACTOR_16b> keep = ::aie::lt(n1, mag) & ::aie::ge(mag, n2);
+    return ::aie::select(::aie::zeros<int16_t, PARALLEL_FACTOR_16b>(), mag, keep);
+}
+
+/**
+ * 16-bit Canny non-maximum suppression (3x3) with border effect handling
+ *
+ * Reads the packed tile of canny_gradient_k3_border and keeps the magnitude
+ * of pixels that are a maximum along their gradient direction, all other
+ * pixels are set to 0. Tile borders are replicated.
+ */
+__attribute__((noinline)) void canny_nms_k3_border(input_window_int16* img_in, output_window_int16* img_out) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    for (int i = 0; i < image_height; i++) {
+        const int16* restrict row0 = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        const int16* restrict row1 = ptr_img_buffer + i * stride;
+        const int16* restrict row2 = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+
+        // Left border
+        *(ptr_out++) = canny_nms_block<true, false>(row0, row1, row2, 0, image_width);
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                *(ptr_out++) = canny_nms_block<false, false>(row0, row1, row2, j, image_width);
+            }
+
+        // Right border
+        *(ptr_out++) = canny_nms_block<false, true>(row0, row1, row2, 0, image_width);
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
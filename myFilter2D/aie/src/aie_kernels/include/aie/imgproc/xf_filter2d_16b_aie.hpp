@@ -17,9 +17,13 @@
 #include <adf.h>
 #include <algorithm>
 #include <common/xf_aie_hw_utils.hpp>
+#include "xf_filter_const.hpp"
+
+#ifndef _AIE_FILTER2D_16B_H_
+#define _AIE_FILTER2D_16B_H_
 
 #define PARALLEL_FACTOR_16b 16 // Parallelization factor for 16b operations (16x mults)
-#define SRS_SHIFT 10           // SRS shift used can be increased if input data likewise adjusted)
+#define SRS_SHIFT xf::cv::aie::FILTER2D_SRS_SHIFT // SRS shift used can be increased if input data likewise adjusted)
 
 namespace xf {
 namespace cv {
@@ -42,19 +46,17 @@ namespace aie {
  *  |8_|__________3____________|9_|  last row
  *
  */
-__attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
-                                                  const int16_t (&coeff)[16],
-                                                  output_window_int16* img_out) {
-    int16* restrict img_in_ptr = (int16*)img_in->ptr;
-    int16* restrict img_out_ptr = (int16*)img_out->ptr;
-
-    // const int16_t image_width = xfGetTileWidth(img_in_ptr);
-    // const int16_t image_height = xfGetTileHeight(img_in_ptr);
-    const int16_t image_width = 64;
-    const int16_t image_height = 64;
-    const int16_t stride = image_width;
-
-    xfCopyMetaData(img_in_ptr, img_out_ptr);
+template <int TILE_W>
+inline void filter2D_k3_border_impl(int16* restrict img_in_ptr,
+                                    int16* restrict img_out_ptr,
+                                    const int16_t (&coeff)[16],
+                                    const int16_t tile_width,
+                                    const int16_t image_height,
+                                    const int shift) {
+    // TILE_W != 0 fixes the column trip count at compile time (fast path),
+    // TILE_W == 0 uses the width read from the tile metadata
+    const int16_t image_width = (TILE_W > 0) ? (int16_t)TILE_W : tile_width;
+    const int16_t stride = image_width; // tile rows are packed back to back
 
     v16int16* restrict ptr_img_buffer = (v16int16*)xfGetImgDataPtr(img_in_ptr);
     v16int16* restrict ptr_img_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
@@ -129,7 +131,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                         2); // k7*d[0-15] +  k8*d[1-16]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -172,7 +174,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                             1); // k8*d[9-24] + 0*d[10-25]
 
                 // Store result
-                data_out = srs(acc, SRS_SHIFT);
+                data_out = srs(acc, shift);
                 *(ptr_out++) = data_out;
             }
 
@@ -216,7 +218,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                         1); // [15{0},k8]*d[16-31] + [15{k8},0]*d[17-32]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -278,7 +280,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                         2); // k7*d[0-15] +  k8*d[1-16]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -323,7 +325,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                             1); // k8*d[9-24] + 0*d[10-25]
 
                 // Store result
-                data_out = srs(acc, SRS_SHIFT);
+                data_out = srs(acc, shift);
                 *(ptr_out++) = data_out;
             }
 
@@ -370,7 +372,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                         1); // [15{0},k8]*d[16-31] + [15{k8},0]*d[17-32]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -425,7 +427,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
             //@}
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
 
             // Update data pointers
@@ -467,7 +469,7 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                             1); // k8*d[9-24] + 0*d[10-25]
 
                 // Store result
-                data_out = srs(acc, SRS_SHIFT);
+                data_out = srs(acc, shift);
                 *(ptr_out++) = data_out;
             }
 
@@ -511,12 +513,504 @@ __attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
                         1); // [15{0},k8]*d[16-31] + [15{k8},0]*d[17-32]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
+            *(ptr_out++) = data_out;
+        }
+    }
+}
+
+/**
+ * 16-bit filter2D (3x3) window interface
+ *
+ * Tile width, height and row stride are read from the tile metadata, so any
+ * tile shape produced by the tiler fits as long as it is no larger than the
+ * window and its width is a multiple of 16 and at least 32. The most common
+ * widths are dispatched to fully unrolled instances. The accumulator is
+ * rounded with 'shift' (defaults to SRS_SHIFT), which lets runtime-updated
+ * coefficient sets pick their own fixed point scale.
+ */
+__attribute__((noinline)) void filter2D_k3_border(input_window_int16* img_in,
+                                                  const int16_t (&coeff)[16],
+                                                  output_window_int16* img_out,
+                                                  const int shift = SRS_SHIFT) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    switch (image_width) {
+        case 64:
+            filter2D_k3_border_impl<64>(img_in_ptr, img_out_ptr, coeff, image_width, image_height, shift);
+            break;
+        case 128:
+            filter2D_k3_border_impl<128>(img_in_ptr, img_out_ptr, coeff, image_width, image_height, shift);
+            break;
+        default:
+            filter2D_k3_border_impl<0>(img_in_ptr, img_out_ptr, coeff, image_width, image_height, shift);
+            break;
+    }
+}
+
+/**
+ * 16-bit filter2D (KxK, K = 5 or 7) with border effect handling
+ *
+ * Kernel row r is stored at coeff[16 * r + 0 .. 16 * r + K - 1], the rest of
+ * each 16-entry row is zero:
+ *
+ * 5x5: k0 k1 k2 k3 k4 0 ...      7x7: k0 k1 k2 k3 k4 k5 k6 0 ...
+ *
+ * The kernel is applied to the whole tile with replicated borders. Tiles
+ * coming from the tiler therefore need an overlap of K/2 pixels (2 for 5x5,
+ * 3 for 7x7) so the stitcher drops every pixel affected by the tile edge.
+ *
+ * Each 16 pixel output vector is built from a v32int16 buffer holding the
+ * pixels [j - 8, j + 23] of every kernel row:
+ *
+ *   ____________________________________________
+ *  | j-8 .. j-1 |   j .. j+15 (out)  | j+16 .. j+23 |
+ *  |____________|____________________|______________|
+ *
+ * Left and right vectors replicate the first / last pixel into the unused
+ * part of that buffer, top and bottom rows are replicated by clamping the
+ * row index.
+ */
+// Row pixels [j - 8, j + 23] for p = row + j - 8. p is only 128-bit aligned,
+// so the buffer is assembled from four v8int16 loads.
+inline v32int16 filter2D_load_row(const int16* restrict p) {
+    v32int16 data_buf = undef_v32int16();
+    data_buf = upd_v(data_buf, 0, *(const v8int16*)(p));      // d[j-8]++d[j-1]
+    data_buf = upd_v(data_buf, 1, *(const v8int16*)(p + 8));  // d[j]++d[j+7]
+    data_buf = upd_v(data_buf, 2, *(const v8int16*)(p + 16)); // d[j+8]++d[j+15]
+    data_buf = upd_v(data_buf, 3, *(const v8int16*)(p + 24)); // d[j+16]++d[j+23]
+    return data_buf;
+}
+
+/**
+ * filter2D_load_row for any block of a row, the first / last pixel is
+ * replicated at the left / right tile border.
+ */
+template <bool LEFT, bool RIGHT>
+inline v32int16 filter2D_load_row_border(const int16* restrict row, const int j, const int16_t image_width) {
+    v32int16 data_buf;
+    if (LEFT) {
+        v16int16 d0 = *(v16int16*)(row);
+        v16int16 d1 = *(v16int16*)(row + PARALLEL_FACTOR_16b);
+        data_buf = upd_v(data_buf, 0, ::aie::broadcast<int16_t, 8>(row[0]));
+        data_buf = upd_v(data_buf, 1, ext_v(d0, 0));
+        data_buf = upd_v(data_buf, 2, ext_v(d0, 1));
+        data_buf = upd_v(data_buf, 3, ext_v(d1, 0));
+    } else if (RIGHT) {
+        const int16* restrict p = row + image_width - PARALLEL_FACTOR_16b;
+        v16int16 d0 = *(v16int16*)(p);
+        data_buf = upd_v(data_buf, 0, *(v8int16*)(p - 8));
+        data_buf = upd_v(data_buf, 1, ext_v(d0, 0));
+        data_buf = upd_v(data_buf, 2, ext_v(d0, 1));
+        data_buf = upd_v(data_buf, 3, ::aie::broadcast<int16_t, 8>(p[PARALLEL_FACTOR_16b - 1]));
+    } else {
+        data_buf = filter2D_load_row(row + j - 8);
+    }
+    return data_buf;
+}
+
+// Pixels j + offset from a row buffer holding pixels [j - 8, j + 23]
+inline ::aie::vector<int16_t, PARALLEL_FACTOR_16b> filter2D_tap(const ::aie::vector<int16_t, 32>& row,
+                                                                const int offset) {
+    return ::aie::shuffle_down(row, 8 + offset).template extract<PARALLEL_FACTOR_16b>(0);
+}
+
+template <int K>
+inline v16acc48 filter2D_kn_mac_row(v16acc48 acc, v32int16 data_buf, v16int16 kernel_vec) {
+    if (K == 3) {
+        acc = mac16(acc, data_buf, 6, 0x03020100, 0x07060504, 0x3221, kernel_vec, 0, 0, 0,
+                    1); // k0*d[j-1] + k1*d[j]
+        acc = mac16(acc, data_buf, 8, 0x03020100, 0x07060504, 0x3221, kernel_vec, 2, 0, 0,
+                    1); // k2*d[j+1] + 0*d[j+2]
+    } else if (K == 5) {
+        acc = mac16(acc, data_buf, 6, 0x03020100, 0x07060504, 0x2110, kernel_vec, 0, 0, 0,
+                    1); // k0*d[j-2] + k1*d[j-1]
+        acc = mac16(acc, data_buf, 8, 0x03020100, 0x07060504, 0x2110, kernel_vec, 2, 0, 0,
+                    1); // k2*d[j] + k3*d[j+1]
+        acc = mac16(acc, data_buf, 10, 0x03020100, 0x07060504, 0x2110, kernel_vec, 4, 0, 0,
+                    1); // k4*d[j+2] + 0*d[j+3]
+    } else {
+        acc = mac16(acc, data_buf, 4, 0x03020100, 0x07060504, 0x3221, kernel_vec, 0, 0, 0,
+                    1); // k0*d[j-3] + k1*d[j-2]
+        acc = mac16(acc, data_buf, 6, 0x03020100, 0x07060504, 0x3221, kernel_vec, 2, 0, 0,
+                    1); // k2*d[j-1] + k3*d[j]
+        acc = mac16(acc, data_buf, 8, 0x03020100, 0x07060504, 0x3221, kernel_vec, 4, 0, 0,
+                    1); // k4*d[j+1] + k5*d[j+2]
+        acc = mac16(acc, data_buf, 10, 0x03020100, 0x07060504, 0x3221, kernel_vec, 6, 0, 0,
+                    1); // k6*d[j+3] + 0*d[j+4]
+    }
+    return acc;
+}
+
+template <int K>
+inline void filter2D_kn_border_impl(int16* restrict img_in_ptr,
+                                    int16* restrict img_out_ptr,
+                                    const int16_t* coeff,
+                                    const int16_t image_width,
+                                    const int16_t image_height,
+                                    const int shift) {
+    static_assert(K == 5 || K == 7, "Only 5x5 and 7x7 kernels are supported");
+    constexpr int R = K / 2;
+
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    v32int16 data_buf;
+    v16int16 data_out;
+    v16acc48 acc;
+
+    for (int i = 0; i < image_height; i++) {
+        int16* restrict row[K];
+        for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                row[r] = ptr_img_buffer + std::min(std::max(i + r - R, 0), image_height - 1) * stride;
+            }
+
+        // **********************************************************************
+        // Left border
+        // **********************************************************************
+        {
+            acc = null_v16acc48();
+            for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                    data_buf = filter2D_load_row_border<true, false>(row[r], 0, image_width);
+                    acc = filter2D_kn_mac_row<K>(acc, data_buf, *(v16int16*)(coeff + 16 * r));
+                }
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
+
+        // **********************************************************************
+        // Middle region: border effect free
+        // **********************************************************************
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                acc = null_v16acc48();
+                for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                        data_buf = filter2D_load_row(row[r] + j - 8);
+                        acc = filter2D_kn_mac_row<K>(acc, data_buf, *(v16int16*)(coeff + 16 * r));
+                    }
+                data_out = srs(acc, shift);
+                *(ptr_out++) = data_out;
+            }
+
+        // **********************************************************************
+        // Right border
+        // **********************************************************************
+        {
+            acc = null_v16acc48();
+            for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                    data_buf =
+                        filter2D_load_row_border<false, true>(row[r], image_width - PARALLEL_FACTOR_16b, image_width);
+                    acc = filter2D_kn_mac_row<K>(acc, data_buf, *(v16int16*)(coeff + 16 * r));
+                }
+            data_out = srs(acc, shift);
+            *(ptr_out++) = data_out;
+        }
+    }
+}
+
+/**
+ * 16-bit filter2D (5x5) window interface, tiler overlap must be 2
+ */
+__attribute__((noinline)) void filter2D_k5_border(input_window_int16* img_in,
+                                                  const int16_t (&coeff)[5 * 16],
+                                                  output_window_int16* img_out,
+                                                  const int shift = SRS_SHIFT) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    filter2D_kn_border_impl<5>(img_in_ptr, img_out_ptr, coeff, image_width, image_height, shift);
+}
+
+/**
+ * 16-bit filter2D (7x7) window interface, tiler overlap must be 3
+ */
+__attribute__((noinline)) void filter2D_k7_border(input_window_int16* img_in,
+                                                  const int16_t (&coeff)[7 * 16],
+                                                  output_window_int16* img_out,
+                                                  const int shift = SRS_SHIFT) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    filter2D_kn_border_impl<7>(img_in_ptr, img_out_ptr, coeff, image_width, image_height, shift);
+}
+
+/**
+ * 16-bit symmetric filter2D (3x3) with border effect handling
+ *
+ * For kernels symmetric about both axes
+ *
+ *   a b a
+ *   c d c
+ *   a b a
+ *
+ * the first and last rows are pre-added (s = d[i-1] + d[i+1]) and the
+ * mirrored columns go through the pre-adder of the symmetric MAC, so every
+ * output vector takes one multiply per unique coefficient:
+ *
+ *   o[j] = a*(s[j-1] + s[j+1]) + b*s[j] + c*(d[i][j-1] + d[i][j+1]) + d*d[i][j]
+ *
+ * Coefficients use the filter2D_k3_border layout, so the same RTP vector
+ * drives both kernels. Only k0 (a), k1 (b), k3 (c) and k4 (d) are read, the
+ * other taps are assumed to mirror them and are not checked here: validate
+ * the kernel on the host (xF::ref::isSymmetricK3) before selecting this
+ * variant. The accumulator and rounding are identical to filter2D_k3_border,
+ * results are bit-identical as long as the pre-added pixels fit into int16,
+ * i.e. signed pixel data of up to 14 bits. ref/filter2d_check -m sym models
+ * the int16 pre-adders.
+ */
+inline ::aie::vector<int16_t, 32> filter2D_sym_row_left(const int16_t* restrict row) {
+    return filter2D_load_row_border<true, false>(row, 0, 0); // d[0]x8|d[0]++d[23]
+}
+
+inline ::aie::vector<int16_t, 32> filter2D_sym_row(const int16_t* restrict row, int j) {
+    return filter2D_load_row(row + j - 8); // d[j-8]++d[j+23]
+}
+
+inline ::aie::vector<int16_t, 32> filter2D_sym_row_right(const int16_t* restrict row, int image_width) {
+    // d[w-24]++d[w-1]|d[w-1]x8
+    return filter2D_load_row_border<false, true>(row, image_width - PARALLEL_FACTOR_16b, image_width);
+}
+
+inline ::aie::vector<int16_t, 16> filter2D_sym_compute(const ::aie::vector<int16_t, 32>& top,
+                                                       const ::aie::vector<int16_t, 32>& mid,
+                                                       const ::aie::vector<int16_t, 32>& bottom,
+                                                       const ::aie::vector<int16_t, 16>& coeff_outer,
+                                                       const ::aie::vector<int16_t, 16>& coeff_mid,
+                                                       const int shift) {
+    ::aie::vector<int16_t, 32> outer = ::aie::add(top, bottom);
+    ::aie::accum<acc48, 16> acc =
+        ::aie::sliding_mul_sym<16, 3>(coeff_outer, 0, outer, 7); // a*(s[j-1]+s[j+1]) + b*s[j]
+    acc = ::aie::sliding_mac_sym<16, 3>(acc, coeff_mid, 0, mid, 7); // c*(d[j-1]+d[j+1]) + d*d[j]
+    return acc.template to_vector<int16_t>(shift);
+}
+
+__attribute__((noinline)) void filter2D_k3_sym_border(input_window_int16* img_in,
+                                                      const int16_t (&coeff)[16],
+                                                      output_window_int16* img_out,
+                                                      const int shift = SRS_SHIFT) {
+    int16_t* restrict img_in_ptr = (int16_t*)img_in->ptr;
+    int16_t* restrict img_out_ptr = (int16_t*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16_t* restrict ptr_img_buffer = (int16_t*)xfGetImgDataPtr(img_in_ptr);
+    int16_t* restrict ptr_out = (int16_t*)xfGetImgDataPtr(img_out_ptr);
+
+    // k0 k1 0 k2 0 k3 k4 0 k5 0 k6 k7 0 k8 0 0 -> {a, b}, {c, d}
+    ::aie::vector<int16_t, 16> coeff_outer = ::aie::zeros<int16_t, 16>();
+    ::aie::vector<int16_t, 16> coeff_mid = ::aie::zeros<int16_t, 16>();
+    coeff_outer[0] = coeff[0];
+    coeff_outer[1] = coeff[1];
+    coeff_mid[0] = coeff[5];
+    coeff_mid[1] = coeff[6];
+
+    for (int i = 0; i < image_height; i++) {
+        const int16_t* restrict row0 = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        const int16_t* restrict row1 = ptr_img_buffer + i * stride;
+        const int16_t* restrict row2 = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+
+        // Left border
+        ::aie::store_v(ptr_out, filter2D_sym_compute(filter2D_sym_row_left(row0), filter2D_sym_row_left(row1),
+                                                     filter2D_sym_row_left(row2), coeff_outer, coeff_mid, shift));
+        ptr_out += PARALLEL_FACTOR_16b;
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                ::aie::store_v(ptr_out, filter2D_sym_compute(filter2D_sym_row(row0, j), filter2D_sym_row(row1, j),
+                                                             filter2D_sym_row(row2, j), coeff_outer, coeff_mid, shift));
+                ptr_out += PARALLEL_FACTOR_16b;
+            }
+
+        // Right border
+        ::aie::store_v(ptr_out, filter2D_sym_compute(filter2D_sym_row_right(row0, image_width),
+                                                     filter2D_sym_row_right(row1, image_width),
+                                                     filter2D_sym_row_right(row2, image_width), coeff_outer,
+                                                     coeff_mid, shift));
+        ptr_out += PARALLEL_FACTOR_16b;
+    }
+}
+
+/**
+ * 16-bit separable filter2D (KxK, K = 3, 5 or 7) with border effect handling
+ *
+ * Rank-1 kernels k[r][c] = v[r] * h[c] are applied as a vertical Kx1 pass
+ * followed by a horizontal 1xK pass, i.e. 2K instead of K^2 multiplies per
+ * pixel. Both tap sets share one 16-entry coefficient array:
+ *
+ *   coeff[0 .. 7]  : h0 .. hK-1, zero padded
+ *   coeff[8 .. 15] : v0 .. vK-1, zero padded
+ *
+ * The vertical pass result of each output row is rounded with 'shift_v' into
+ * a line buffer padded with 16 replicated pixels on either side, so the
+ * horizontal pass (rounded with 'shift_h') needs no border regions. Results
+ * match the 2D kernel up to the intermediate rounding. Tiles need an overlap
+ * of K/2 pixels and a width of at most MAX_W.
+ */
+template <int K, int MAX_W = 256>
+__attribute__((noinline)) void filter2D_separable_border(input_window_int16* img_in,
+                                                         const int16_t (&coeff)[16],
+                                                         output_window_int16* img_out,
+                                                         const int shift_h,
+                                                         const int shift_v) {
+    static_assert(K == 3 || K == 5 || K == 7, "Only 3x3, 5x5 and 7x7 kernels are supported");
+    constexpr int R = K / 2;
+
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    alignas(32) int16_t line[PARALLEL_FACTOR_16b + MAX_W + PARALLEL_FACTOR_16b];
+    int16_t* restrict line_data = line + PARALLEL_FACTOR_16b;
+
+    v16int16 kernel_vec_h = *(v16int16*)(&coeff[0]);
+    v32int16 data_buf;
+    v16int16 data_out;
+    v16acc48 acc;
+
+    for (int i = 0; i < image_height; i++) {
+        int16* restrict row[K];
+        for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                row[r] = ptr_img_buffer + std::min(std::max(i + r - R, 0), image_height - 1) * stride;
+            }
+
+        // Vertical pass: v0*d[i-R] + ... + vK-1*d[i+R] -> line buffer
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_16b) chess_prepare_for_pipelining {
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> vacc =
+                    ::aie::mul(::aie::load_v<PARALLEL_FACTOR_16b>(row[0] + j), coeff[8]);
+                for (int r = 1; r < K; r++) chess_unroll_loop(*) {
+                        vacc = ::aie::mac(vacc, ::aie::load_v<PARALLEL_FACTOR_16b>(row[r] + j), coeff[8 + r]);
+                    }
+                ::aie::store_v(line_data + j, vacc.template to_vector<int16_t>(shift_v));
+            }
+
+        // Replicate first / last pixel into the line buffer padding
+        ::aie::store_v(line_data - 8, ::aie::broadcast<int16_t, 8>(line_data[0]));
+        ::aie::store_v(line_data + image_width, ::aie::broadcast<int16_t, 8>(line_data[image_width - 1]));
+
+        // Horizontal pass: h0*l[j-R] + ... + hK-1*l[j+R]
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_16b) chess_prepare_for_pipelining {
+                data_buf = filter2D_load_row(line_data + j - 8); // l[j-8]++l[j+23]
+                acc = filter2D_kn_mac_row<K>(null_v16acc48(), data_buf, kernel_vec_h);
+                data_out = srs(acc, shift_h);
+                *(ptr_out++) = data_out;
+            }
+    }
+}
+
+// Reads one row of the stream into the line buffer and replicates its edge pixels into the padding
+inline void filter2D_stream_read_row(input_stream_int16* img_in, int16_t* restrict line, const int image_width) {
+    for (int j = 0; j < image_width; j += 8) chess_prepare_for_pipelining {
+            *(v8int16*)(line + j) = readincr_v8(img_in);
+        }
+    *(v8int16*)(line - 8) = ::aie::broadcast<int16_t, 8>(line[0]);
+    *(v8int16*)(line + image_width) = ::aie::broadcast<int16_t, 8>(line[image_width - 1]);
+}
+
+/**
+ * 16-bit filter2D (KxK, K = 3, 5 or 7) stream interface with line buffer
+ *
+ * Every call consumes a full-width band of 'band_height' rows of
+ * 'image_width' pixels from the input stream, without metadata header. The
+ * last K rows of the frame are kept in a static line buffer across calls, so
+ * bands join without a seam and no vertical overlap has to be re-sent.
+ * Output row o is emitted once input row o + R has arrived: the first band
+ * of a frame emits band_height - R rows, the last one flushes R extra rows,
+ * 'frame_height' rows in total. A band of at most R rows still consumes its
+ * rows, its outputs follow with the next band. Rows are replicated only at the top and
+ * bottom of the frame. Every buffered row is padded with 16 replicated
+ * pixels on either side, so left and right borders need no special regions.
+ *
+ * Coefficients use the filter2D_kn_border layout (kernel row r at
+ * coeff[16 * r]). Width must be a multiple of 16 and at most MAX_W,
+ * frame_height a multiple of band_height and at least K.
+ */
+template <int K, int MAX_W = 256>
+__attribute__((noinline)) void filter2D_stream_border(input_stream_int16* img_in,
+                                                      const int16_t (&coeff)[K * 16],
+                                                      output_stream_int16* img_out,
+                                                      const int image_width,
+                                                      const int band_height,
+                                                      const int frame_height,
+                                                      const int shift = SRS_SHIFT) {
+    static_assert(K == 3 || K == 5 || K == 7, "Only 3x3, 5x5 and 7x7 kernels are supported");
+    constexpr int R = K / 2;
+    constexpr int LINE_STRIDE = PARALLEL_FACTOR_16b + MAX_W + PARALLEL_FACTOR_16b;
+
+    alignas(32) static int16_t line_buffer[K][LINE_STRIDE];
+    // Input rows of the current frame consumed so far, persists across bands
+    static int rows_read = 0;
+
+    v32int16 data_buf;
+    v16int16 data_out;
+    v16acc48 acc;
+
+    const int band_end = rows_read + band_height;
+    const int last_out = (band_end == frame_height) ? frame_height : band_end - R;
+    for (int o = std::max(rows_read - R, 0); o < last_out; o++) {
+        // Fetch input rows up to o + R, the frame bottom is reached on the last band only
+        for (; rows_read <= std::min(o + R, frame_height - 1); rows_read++) {
+            filter2D_stream_read_row(img_in, line_buffer[rows_read % K] + PARALLEL_FACTOR_16b, image_width);
+        }
+
+        int16_t* restrict row[K];
+        for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                row[r] = line_buffer[std::min(std::max(o + r - R, 0), frame_height - 1) % K] + PARALLEL_FACTOR_16b;
+            }
+
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_16b) chess_prepare_for_pipelining {
+                acc = null_v16acc48();
+                for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                        data_buf = filter2D_load_row(row[r] + j - 8);
+                        acc = filter2D_kn_mac_row<K>(acc, data_buf, *(v16int16*)(coeff + 16 * r));
+                    }
+                data_out = srs(acc, shift);
+                writeincr_v8(img_out, ext_v(data_out, 0));
+                writeincr_v8(img_out, ext_v(data_out, 1));
+            }
+    }
+
+    // Rows of a band too short to emit an output
+    for (; rows_read < band_end; rows_read++) {
+        filter2D_stream_read_row(img_in, line_buffer[rows_read % K] + PARALLEL_FACTOR_16b, image_width);
     }
+
+    // Next call starts a new frame
+    if (rows_read == frame_height) rows_read = 0;
 }
 
 } // aie
 } // cv
 } // xf
+
+#endif
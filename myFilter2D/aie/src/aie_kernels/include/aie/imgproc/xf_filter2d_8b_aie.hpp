@@ -0,0 +1,136 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+
+#ifndef _AIE_FILTER2D_8B_H_
+#define _AIE_FILTER2D_8B_H_
+
+#include "xf_filter_const.hpp"
+
+#define PARALLEL_FACTOR_8b 32 // Parallelization factor for 8b operations (32x lanes)
+#define SRS_SHIFT_8b xf::cv::aie::FILTER2D_8B_SRS_SHIFT
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+/**
+ * 8-bit filter2D (3x3) with border effect handling
+ *
+ * uint8 pixels and int8 Q7 coefficients go straight into the 8-bit MACs,
+ * 32 output pixels per vector: per kernel row one 3 point sliding MAC over
+ * the buffered pixels d[j-16] .. d[j+47], accumulated in acc48. The result
+ * is rounded by 'shift' and saturated to uint8.
+ *
+ * Coefficients use the filter2D_k3_border layout (k0 k1 0 k2 0 k3 k4 0 k5 0
+ * k6 k7 0 k8 0 0) with int8 values. The tile keeps the usual metadata header,
+ * pixel data is uint8 and the tile width must be a multiple of 32.
+ */
+template <bool FIRST_COL, bool LAST_COL>
+inline ::aie::vector<uint8_t, 64> filter2D_8b_load_row(const uint8_t* restrict row, const int j, const int width) {
+    // row + j - 16 is only 128-bit aligned, assemble d[j-16]++d[j+47] from 16 pixel loads
+    const uint8_t* restrict p = row + j - 16;
+    ::aie::vector<uint8_t, 16> left = FIRST_COL ? ::aie::broadcast<uint8_t, 16>(row[0]) : ::aie::load_v<16>(p);
+    ::aie::vector<uint8_t, 16> right =
+        LAST_COL ? ::aie::broadcast<uint8_t, 16>(row[width - 1]) : ::aie::load_v<16>(p + 48);
+    return ::aie::concat(left, ::aie::load_v<16>(p + 16), ::aie::load_v<16>(p + 32), right);
+}
+
+template <bool FIRST_COL, bool LAST_COL>
+inline void filter2D_8b_block(const uint8_t* restrict row0,
+                              const uint8_t* restrict row1,
+                              const uint8_t* restrict row2,
+                              const int j,
+                              const int width,
+                              uint8_t* restrict out,
+                              const ::aie::vector<int8_t, 32>& kernel_vec,
+                              const int shift) {
+    // lane t, point c: k[8 * r + c] * d[j + t + c - 1], d[j-1] sits at index 15
+    ::aie::accum<acc48, PARALLEL_FACTOR_8b> acc = ::aie::sliding_mul<PARALLEL_FACTOR_8b, 3>(
+        kernel_vec, 0, filter2D_8b_load_row<FIRST_COL, LAST_COL>(row0, j, width), 15);
+    acc = ::aie::sliding_mac<PARALLEL_FACTOR_8b, 3>(acc, kernel_vec, 8,
+                                                    filter2D_8b_load_row<FIRST_COL, LAST_COL>(row1, j, width), 15);
+    acc = ::aie::sliding_mac<PARALLEL_FACTOR_8b, 3>(acc, kernel_vec, 16,
+                                                    filter2D_8b_load_row<FIRST_COL, LAST_COL>(row2, j, width), 15);
+    ::aie::store_v(out, acc.template to_vector<uint8_t>(shift));
+}
+
+__attribute__((noinline)) void filter2D_k3_border_8b(input_window_uint8* img_in,
+                                                     const int8_t (&coeff)[16],
+                                                     output_window_uint8* img_out,
+                                                     const int shift = SRS_SHIFT_8b) {
+    uint8_t* restrict img_in_ptr = (uint8_t*)img_in->ptr;
+    uint8_t* restrict img_out_ptr = (uint8_t*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    const uint8_t* restrict ptr_img_buffer = (const uint8_t*)xfGetImgDataPtr(img_in_ptr);
+    uint8_t* restrict ptr_out = (uint8_t*)xfGetImgDataPtr(img_out_ptr);
+
+    // k0 k1 0 k2 0 k3 k4 0 k5 0 k6 k7 0 k8 0 0 -> kernel row r at kernel_vec[8 * r]
+    ::aie::vector<int8_t, 32> kernel_vec = ::aie::zeros<int8_t, 32>();
+    const int k3_index[9] = {0, 1, 3, 5, 6, 8, 10, 11, 13};
+    for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+            for (int c = 0; c < 3; c++) chess_unroll_loop(*) { kernel_vec[8 * r + c] = coeff[k3_index[3 * r + c]]; }
+        }
+
+    set_sat();
+    for (int i = 0; i < image_height; i++) {
+        const uint8_t* restrict row0 = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        const uint8_t* restrict row1 = ptr_img_buffer + i * stride;
+        const uint8_t* restrict row2 = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+
+        if (image_width == PARALLEL_FACTOR_8b) {
+            filter2D_8b_block<true, true>(row0, row1, row2, 0, image_width, ptr_out, kernel_vec, shift);
+            ptr_out += PARALLEL_FACTOR_8b;
+            continue;
+        }
+
+        //@Left border {
+        filter2D_8b_block<true, false>(row0, row1, row2, 0, image_width, ptr_out, kernel_vec, shift);
+        ptr_out += PARALLEL_FACTOR_8b;
+        //@}
+
+        //@Middle region {
+        for (int j = PARALLEL_FACTOR_8b; j < image_width - PARALLEL_FACTOR_8b; j += PARALLEL_FACTOR_8b)
+            chess_prepare_for_pipelining {
+                filter2D_8b_block<false, false>(row0, row1, row2, j, image_width, ptr_out, kernel_vec, shift);
+                ptr_out += PARALLEL_FACTOR_8b;
+            }
+        //@}
+
+        //@Right border {
+        filter2D_8b_block<false, true>(row0, row1, row2, image_width - PARALLEL_FACTOR_8b, image_width, ptr_out,
+                                       kernel_vec, shift);
+        ptr_out += PARALLEL_FACTOR_8b;
+        //@}
+    }
+    clr_sat();
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
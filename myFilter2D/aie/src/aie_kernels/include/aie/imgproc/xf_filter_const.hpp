@@ -0,0 +1,46 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_FILTER_CONST_H_
+#define _XF_FILTER_CONST_H_
+
+// Fixed point formats shared by the filter kernels and the host code that
+// fills their runtime parameters
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Coefficients of filter2D_k3_border and the KxK variants are Q10
+static constexpr int FILTER2D_SRS_SHIFT = 10;
+
+// The 8-bit filter2D takes int8 Q7 coefficients
+static constexpr int FILTER2D_8B_SRS_SHIFT = 7;
+
+// Fractional bits of the unsharp mask amount in coeff[15] (256 = 1.0)
+static constexpr int UNSHARP_AMOUNT_BITS = 8;
+
+// Bilateral spatial weights sum to 1 << BILATERAL_WEIGHT_BITS, the centre
+// weight bounds the normalization denominator from below so its reciprocal
+// fits int16
+static constexpr int BILATERAL_WEIGHT_BITS = 10;
+static constexpr int BILATERAL_MIN_CENTRE_WEIGHT = 64;
+
+} // aie
+} // cv
+} // xf
+
+#endif
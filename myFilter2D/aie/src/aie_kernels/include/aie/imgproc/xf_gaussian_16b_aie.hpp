@@ -15,11 +15,13 @@
  */
 
 #include <adf.h>
+#include <aie_api/aie.hpp>
 #include <common/xf_aie_hw_utils.hpp>
 #include <algorithm>
+#include "xf_filter2d_16b_aie.hpp"
 
-#define PARALLEL_FACTOR_16b 16 // Parallelization factor for 16b operations (16x mults)
-#define SRS_SHIFT 10           // SRS shift used can be increased if input data likewise adjusted)
+#ifndef _AIE_GAUSSIAN_16B_H_
+#define _AIE_GAUSSIAN_16B_H_
 
 namespace xf {
 namespace cv {
@@ -41,10 +43,14 @@ namespace aie {
  *  |  |                       |  |
  *  |8_|__________3____________|9_|  last row
  *
+ * Coefficients use the filter2D_k3_border layout and are rounded with
+ * 'shift', so both can come from a runtime parameter computed on the host
+ * for the current sigma.
  */
 __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                                                   const int16_t (&coeff)[16],
-                                                  output_window_int16* img_out) {
+                                                  output_window_int16* img_out,
+                                                  const int shift = SRS_SHIFT) {
     int16* restrict img_in_ptr = (int16*)img_in->ptr;
     int16* restrict img_out_ptr = (int16*)img_out->ptr;
 
@@ -126,7 +132,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                         2); // k7*d[0-15] +  k8*d[1-16]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -169,7 +175,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                             1); // k8*d[9-24] + 0*d[10-25]
 
                 // Store result
-                data_out = srs(acc, SRS_SHIFT);
+                data_out = srs(acc, shift);
                 *(ptr_out++) = data_out;
             }
 
@@ -213,7 +219,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                         1); // [15{0},k8]*d[16-31] + [15{k8},0]*d[17-32]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -275,7 +281,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                         2); // k7*d[0-15] +  k8*d[1-16]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -320,7 +326,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                             1); // k8*d[9-24] + 0*d[10-25]
 
                 // Store result
-                data_out = srs(acc, SRS_SHIFT);
+                data_out = srs(acc, shift);
                 *(ptr_out++) = data_out;
             }
 
@@ -367,7 +373,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                         1); // [15{0},k8]*d[16-31] + [15{k8},0]*d[17-32]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
 
@@ -422,7 +428,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
             //@}
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
 
             // Update data pointers
@@ -464,7 +470,7 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                             1); // k8*d[9-24] + 0*d[10-25]
 
                 // Store result
-                data_out = srs(acc, SRS_SHIFT);
+                data_out = srs(acc, shift);
                 *(ptr_out++) = data_out;
             }
 
@@ -508,12 +514,99 @@ __attribute__((noinline)) void gaussian_k3_border(input_window_int16* img_in,
                         1); // [15{0},k8]*d[16-31] + [15{k8},0]*d[17-32]
 
             // Store result
-            data_out = srs(acc, SRS_SHIFT);
+            data_out = srs(acc, shift);
             *(ptr_out++) = data_out;
         }
     }
 }
 
+/**
+ * 16-bit gaussian (5x5) with border effect handling
+ *
+ * The Gaussian is separable and symmetric, so only the three unique 1D taps
+ * are needed:
+ *
+ *   coeff[0] : g0 (centre)
+ *   coeff[1] : g1
+ *   coeff[2] : g2
+ *
+ * Vertical pass, mirrored rows are pre-added (3 multiplies instead of 5):
+ *
+ *   v[j] = g0*d[i][j] + g1*(d[i-1][j] + d[i+1][j]) + g2*(d[i-2][j] + d[i+2][j])
+ *
+ * and rounded with 'shift_v' into a line buffer padded with replicated
+ * pixels. The horizontal pass uses the pre-adder of the symmetric MAC:
+ *
+ *   o[j] = g2*(v[j-2] + v[j+2]) + g1*(v[j-1] + v[j+1]) + g0*v[j]
+ *
+ * rounded with 'shift_h'. Top and bottom rows are replicated by clamping the
+ * row index. Pre-added pixel pairs must fit into int16 (pixel data of up to
+ * 14 bits), tiles need an overlap of 2 and a width of at most MAX_W.
+ */
+template <int MAX_W = 256>
+__attribute__((noinline)) void gaussian_k5_sym_border(input_window_int16* img_in,
+                                                      const int16_t (&coeff)[16],
+                                                      output_window_int16* img_out,
+                                                      const int shift_h,
+                                                      const int shift_v) {
+    int16_t* restrict img_in_ptr = (int16_t*)img_in->ptr;
+    int16_t* restrict img_out_ptr = (int16_t*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16_t* restrict ptr_img_buffer = (int16_t*)xfGetImgDataPtr(img_in_ptr);
+    int16_t* restrict ptr_out = (int16_t*)xfGetImgDataPtr(img_out_ptr);
+
+    alignas(32) int16_t line[PARALLEL_FACTOR_16b + MAX_W + PARALLEL_FACTOR_16b];
+    int16_t* restrict line_data = line + PARALLEL_FACTOR_16b;
+
+    // g0 g1 g2 -> {g2, g1, g0} for the symmetric sliding MAC
+    ::aie::vector<int16_t, 16> coeff_h = ::aie::zeros<int16_t, 16>();
+    coeff_h[0] = coeff[2];
+    coeff_h[1] = coeff[1];
+    coeff_h[2] = coeff[0];
+
+    for (int i = 0; i < image_height; i++) {
+        const int16_t* restrict row0 = ptr_img_buffer + std::max(i - 2, 0) * stride;
+        const int16_t* restrict row1 = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        const int16_t* restrict row2 = ptr_img_buffer + i * stride;
+        const int16_t* restrict row3 = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+        const int16_t* restrict row4 = ptr_img_buffer + std::min(i + 2, image_height - 1) * stride;
+
+        // Vertical pass -> line buffer
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_16b) chess_prepare_for_pipelining {
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> outer =
+                    ::aie::add(::aie::load_v<16>(row0 + j), ::aie::load_v<16>(row4 + j));
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> inner =
+                    ::aie::add(::aie::load_v<16>(row1 + j), ::aie::load_v<16>(row3 + j));
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> vacc =
+                    ::aie::mul(::aie::load_v<PARALLEL_FACTOR_16b>(row2 + j), coeff[0]);
+                vacc = ::aie::mac(vacc, inner, coeff[1]);
+                vacc = ::aie::mac(vacc, outer, coeff[2]);
+                ::aie::store_v(line_data + j, vacc.template to_vector<int16_t>(shift_v));
+            }
+
+        // Replicate first / last pixel into the line buffer padding
+        ::aie::store_v(line_data - 8, ::aie::broadcast<int16_t, 8>(line_data[0]));
+        ::aie::store_v(line_data + image_width, ::aie::broadcast<int16_t, 8>(line_data[image_width - 1]));
+
+        // Horizontal pass
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_16b) chess_prepare_for_pipelining {
+                ::aie::vector<int16_t, 32> data(filter2D_load_row(line_data + j - 8)); // v[j-8]++v[j+23]
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> acc =
+                    ::aie::sliding_mul_sym<PARALLEL_FACTOR_16b, 5>(coeff_h, 0, data, 6);
+                ::aie::store_v(ptr_out, acc.template to_vector<int16_t>(shift_h));
+                ptr_out += PARALLEL_FACTOR_16b;
+            }
+    }
+}
+
 } // aie
 } // cv
 } // xf
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_sobel_16b_aie.hpp"
+
+#ifndef _AIE_HARRIS_16B_H_
+#define _AIE_HARRIS_16B_H_
+
+#define HARRIS_GRAD_SHIFT 2 // Sobel gradients of 8-bit data scaled to 8 bits + sign
+#define HARRIS_SUM_SHIFT 6  // 3x3 sums of gradient products scaled to int16
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+/**
+ * Sobel gradients of input row r, rounded with HARRIS_GRAD_SHIFT into the
+ * line buffers gx / gy, which get 16 replicated pixels on either side.
+ */
+inline void harris_gradient_row(const int16* restrict img,
+                                const int r,
+                                const int16_t image_width,
+                                const int16_t image_height,
+                                const v16int16 (&kx)[2],
+                                const v16int16 (&ky)[2],
+                                int16_t* restrict gx,
+                                int16_t* restrict gy) {
+    const int16* restrict row0 = img + std::max(r - 1, 0) * image_width;
+    const int16* restrict row1 = img + r * image_width;
+    const int16* restrict row2 = img + std::min(r + 1, image_height - 1) * image_width;
+
+    v16acc48 acc_x;
+    v16acc48 acc_y;
+
+    // Left border
+    sobel_k3_block<true, false>(row0, row1, row2, 0, image_width, kx, ky, acc_x, acc_y);
+    *(v16int16*)(gx) = srs(acc_x, HARRIS_GRAD_SHIFT);
+    *(v16int16*)(gy) = srs(acc_y, HARRIS_GRAD_SHIFT);
+
+    // Middle region: border effect free
+    for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+        chess_prepare_for_pipelining {
+            sobel_k3_block<false, false>(row0, row1, row2, j, image_width, kx, ky, acc_x, acc_y);
+            *(v16int16*)(gx + j) = srs(acc_x, HARRIS_GRAD_SHIFT);
+            *(v16int16*)(gy + j) = srs(acc_y, HARRIS_GRAD_SHIFT);
+        }
+
+    // Right border
+    const int j = image_width - PARALLEL_FACTOR_16b;
+    sobel_k3_block<false, true>(row0, row1, row2, 0, image_width, kx, ky, acc_x, acc_y);
+    *(v16int16*)(gx + j) = srs(acc_x, HARRIS_GRAD_SHIFT);
+    *(v16int16*)(gy + j) = srs(acc_y, HARRIS_GRAD_SHIFT);
+
+    ::aie::store_v(gx - 8, ::aie::broadcast<int16_t, 8>(gx[0]));
+    ::aie::store_v(gy - 8, ::aie::broadcast<int16_t, 8>(gy[0]));
+    ::aie::store_v(gx + image_width, ::aie::broadcast<int16_t, 8>(gx[image_width - 1]));
+    ::aie::store_v(gy + image_width, ::aie::broadcast<int16_t, 8>(gy[image_width - 1]));
+}
+
+/**
+ * 16-bit Harris corner response (3x3 Sobel, 3x3 box window)
+ *
+ * For every pixel the structure tensor is summed over its 3x3 neighbourhood
+ *
+ *   A = sum(Ix*Ix)   B = sum(Ix*Iy)   C = sum(Iy*Iy)
+ *
+ * and the response R = A*C - B*B - k*(A + C)^2 is written in fixed point,
+ * rounded with 'shift'. k is in Q15 (0.04 -> 1311). The gradients of the
+ * last three rows are kept in rolling line buffers, so every gradient is
+ * computed once per tile. Tile geometry comes from the metadata like
+ * erode_rect_3x3_api, the tiler overlap must cover the Sobel and the box
+ * window (2 pixels, plus the overlap of any preceding filter stage). Pixel
+ * data is expected to be 8-bit, tile width at most MAX_W. The response is
+ * signed, output tiles are flagged for signed saturation.
+ */
+template <int MAX_W = 256>
+__attribute__((noinline)) void harris_k3_border(input_window_int16* img_in,
+                                                output_window_int16* img_out,
+                                                const int16_t k,
+                                                const int shift) {
+    constexpr int LINE_STRIDE = PARALLEL_FACTOR_16b + MAX_W + PARALLEL_FACTOR_16b;
+
+    alignas(32) static int16_t grad_x[3][LINE_STRIDE];
+    alignas(32) static int16_t grad_y[3][LINE_STRIDE];
+
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+    xfSignedSaturation(img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    int16_t* restrict ptr_out = (int16_t*)xfGetImgDataPtr(img_out_ptr);
+
+    v16int16 kx[2];
+    v16int16 ky[2];
+    sobel_k3_coeff(1, 2, kx, ky);
+
+    int rows_done = 0;
+    for (int i = 0; i < image_height; i++) {
+        // Gradients up to row i + 1 (clamped to the tile)
+        for (; rows_done <= std::min(i + 1, image_height - 1); rows_done++) {
+            harris_gradient_row(ptr_img_buffer, rows_done, image_width, image_height, kx, ky,
+                                grad_x[rows_done % 3] + PARALLEL_FACTOR_16b,
+                                grad_y[rows_done % 3] + PARALLEL_FACTOR_16b);
+        }
+
+        const int16_t* restrict gx[3];
+        const int16_t* restrict gy[3];
+        for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+                const int slot = std::min(std::max(i + r - 1, 0), image_height - 1) % 3;
+                gx[r] = grad_x[slot] + PARALLEL_FACTOR_16b;
+                gy[r] = grad_y[slot] + PARALLEL_FACTOR_16b;
+            }
+
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_16b) chess_prepare_for_pipelining {
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> sxx = ::aie::zeros<acc48, PARALLEL_FACTOR_16b>();
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> syy = ::aie::zeros<acc48, PARALLEL_FACTOR_16b>();
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> sxy = ::aie::zeros<acc48, PARALLEL_FACTOR_16b>();
+
+                for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+                        ::aie::vector<int16_t, 32> lx(filter2D_load_row(gx[r] + j - 8));
+                        ::aie::vector<int16_t, 32> ly(filter2D_load_row(gy[r] + j - 8));
+                        for (int o = -1; o <= 1; o++) chess_unroll_loop(*) {
+                                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> ix = filter2D_tap(lx, o);
+                                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> iy = filter2D_tap(ly, o);
+                                sxx = ::aie::mac(sxx, ix, ix);
+                                syy = ::aie::mac(syy, iy, iy);
+                                sxy = ::aie::mac(sxy, ix, iy);
+                            }
+                    }
+
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> a = sxx.template to_vector<int16_t>(HARRIS_SUM_SHIFT);
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> b = sxy.template to_vector<int16_t>(HARRIS_SUM_SHIFT);
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> c = syy.template to_vector<int16_t>(HARRIS_SUM_SHIFT);
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> trace = ::aie::add(a, c);
+                ::aie::vector<int16_t, PARALLEL_FACTOR_16b> k_trace =
+                    ::aie::mul(trace, k).template to_vector<int16_t>(15);
+
+                ::aie::accum<acc48, PARALLEL_FACTOR_16b> acc = ::aie::mul(a, c); // A*C
+                acc = ::aie::msc(acc, b, b);                                     // - B*B
+                acc = ::aie::msc(acc, k_trace, trace);                           // - k*(A+C)^2
+                ::aie::store_v(ptr_out, acc.template to_vector<int16_t>(shift));
+                ptr_out += PARALLEL_FACTOR_16b;
+            }
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
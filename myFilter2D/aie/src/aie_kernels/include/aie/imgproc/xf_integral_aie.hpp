@@ -0,0 +1,226 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+
+#ifndef _AIE_INTEGRAL_H_
+#define _AIE_INTEGRAL_H_
+
+#define PARALLEL_FACTOR_32b 16 // Parallelization factor for 32b operations
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Inclusive prefix sum over the lanes (log-step scan)
+inline ::aie::vector<int32_t, PARALLEL_FACTOR_32b> integral_scan(::aie::vector<int32_t, PARALLEL_FACTOR_32b> v) {
+    const ::aie::vector<int32_t, PARALLEL_FACTOR_32b> zero = ::aie::zeros<int32_t, PARALLEL_FACTOR_32b>();
+    for (int s = 1; s < PARALLEL_FACTOR_32b; s *= 2) chess_unroll_loop(*) {
+            // the lowest s lanes of the shuffle wrap around, drop them
+            ::aie::mask<PARALLEL_FACTOR_32b> keep = ::aie::mask<PARALLEL_FACTOR_32b>::from_uint32(0xffffu << s);
+            v = ::aie::add(v, ::aie::select(zero, ::aie::shuffle_up(v, s), keep));
+        }
+    return v;
+}
+
+// One row of the summed-area table: running row sum plus the row above
+template <bool FIRST>
+inline void integral_row(const int16* restrict in_row,
+                         const int32* restrict sat_prev,
+                         int32* restrict sat_row,
+                         const int16_t image_width) {
+    int32_t carry = 0;
+    for (int j = 0; j < image_width; j += PARALLEL_FACTOR_32b) chess_prepare_for_pipelining {
+            ::aie::accum<acc48, PARALLEL_FACTOR_32b> acc;
+            acc.from_vector(::aie::load_v<PARALLEL_FACTOR_32b>(in_row + j), 0);
+            ::aie::vector<int32_t, PARALLEL_FACTOR_32b> v =
+                ::aie::add(integral_scan(acc.template to_vector<int32_t>(0)), carry);
+            carry = v[PARALLEL_FACTOR_32b - 1];
+            if (!FIRST) v = ::aie::add(v, ::aie::load_v<PARALLEL_FACTOR_32b>(sat_prev + j));
+            ::aie::store_v(sat_row + j, v);
+        }
+}
+
+// sat[y * width + x] = sum of in[0..y][0..x], both packed width x height
+inline void integral_image_impl(const int16* restrict in,
+                                int32* restrict sat,
+                                const int16_t image_width,
+                                const int16_t image_height) {
+    integral_row<true>(in, sat, sat, image_width);
+    for (int i = 1; i < image_height; i++) {
+        integral_row<false>(in + i * image_width, sat + (i - 1) * image_width, sat + i * image_width, image_width);
+    }
+}
+
+/**
+ * 32-bit summed-area table of a 16-bit tile
+ *
+ * The output tile has the input geometry with int32 pixels, each one the
+ * sum of the tile pixels above and to the left of it (inclusive). Tables
+ * are local to the tile: the host adds the sums of the tiles above and to
+ * the left, which it finds through xfGetTilePosH / xfGetTilePosV (see
+ * integralCombineTiles), so tiles must not overlap. Metadata is copied to
+ * the output tile.
+ */
+__attribute__((noinline)) void integral_image(input_window_int16* img_in, output_window_int32* img_out) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int32* restrict img_out_ptr = (int32*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    integral_image_impl((int16*)xfGetImgDataPtr(img_in_ptr), (int32*)xfGetImgDataPtr(img_out_ptr), image_width,
+                        image_height);
+}
+
+// Box window reciprocals ((1 << (14 + e)) + n / 2) / n share the exponent e,
+// the largest one that keeps the reciprocal of the smallest count n_min an
+// int16, so every count of a tile gets at least 14 significant bits.
+inline int box_recip_exp(const int n_min) {
+    int e = 0;
+    while (((1 << (15 + e)) + n_min / 2) / n_min <= 32767) e++;
+    return e;
+}
+
+inline int16_t box_recip(const int n, const int e) {
+    return (int16_t)(((1 << (14 + e)) + n / 2) / n);
+}
+
+// row[x + l], l = 0 .. 15, for any x: aligned loads then a lane shift.
+// Reads up to 8 elements past row[x + 15].
+inline ::aie::vector<int32_t, PARALLEL_FACTOR_32b> box_load_at(const int32* restrict row, const int x) {
+    const int32* restrict p = row + (x & ~7);
+    ::aie::vector<int32_t, 32> buf = ::aie::zeros<int32_t, 32>();
+    buf.insert(0, ::aie::load_v<8>(p));
+    buf.insert(1, ::aie::load_v<8>(p + 8));
+    buf.insert(2, ::aie::load_v<8>(p + 16));
+    return ::aie::shuffle_down(buf, x & 7).template extract<PARALLEL_FACTOR_32b>(0);
+}
+
+// int16 pixels p[0 .. 15] widened to int32
+inline ::aie::vector<int32_t, PARALLEL_FACTOR_32b> box_widen(const int16* restrict p) {
+    ::aie::accum<acc48, PARALLEL_FACTOR_32b> acc;
+    acc.from_vector(::aie::load_v<PARALLEL_FACTOR_32b>(p), 0);
+    return acc.template to_vector<int32_t>(0);
+}
+
+/**
+ * 16-bit box (mean) filter of any radius up to MAX_R on a summed-area table
+ *
+ * A box sum is the difference of two rows of the tile's summed-area table,
+ * which is the row prefix sum of the column sums over the window rows. The
+ * kernel keeps those column sums as a running sum (one row enters, one
+ * leaves per output row) and rebuilds that one prefix row per output row,
+ * so the cost does not depend on the radius and tile memory holds rows
+ * only. The prefix row is padded with zeros on the left and its last value
+ * on the right, which clips the windows at the tile edges without scalar
+ * border code. Windows are normalized by the number of pixels they cover,
+ * through per row and per column reciprocals. radius is clamped to
+ * [0, MAX_R], tiles need an overlap of at least radius and widths must be
+ * multiples of 16 up to MAX_W. Metadata is copied to the output tile.
+ */
+template <int MAX_W, int MAX_R>
+__attribute__((noinline)) void box_filter_integral(input_window_int16* img_in,
+                                                   output_window_int16* img_out,
+                                                   const int radius) {
+    static constexpr int FRAC_BITS = 4; // kept on sum / rows
+    // box_load_at reads prefix row columns -MAX_R - 8 .. width + MAX_R + 7
+    static constexpr int PAD = (MAX_R + 15) / 8 * 8;
+
+    alignas(32) static int32 col_sum[MAX_W];
+    alignas(32) static int32 prefix[PAD + MAX_W + PAD];
+    alignas(32) static int16_t col_recip[MAX_W];
+
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int R = std::min(std::max(radius, 0), MAX_R);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    const int16* restrict in = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+    int32* restrict sat_row = prefix + PAD;
+
+    // Windows cover between min(R + 1, size) and 2R + 1 rows / columns
+    const int row_exp = box_recip_exp(std::min(R + 1, (int)image_height));
+    const int col_exp = box_recip_exp(std::min(R + 1, (int)image_width));
+    for (int x = 0; x < image_width; x++) {
+        col_recip[x] = box_recip(std::min(x + R, image_width - 1) - std::max(x - R, 0) + 1, col_exp);
+    }
+
+    const ::aie::vector<int32_t, PARALLEL_FACTOR_32b> bias =
+        ::aie::broadcast<int32_t, PARALLEL_FACTOR_32b>(1 << (13 + col_exp + FRAC_BITS));
+
+    // Column sums of rows 0 .. R - 1, the first output row adds row R
+    for (int j = 0; j < image_width; j += PARALLEL_FACTOR_32b) {
+        ::aie::vector<int32_t, PARALLEL_FACTOR_32b> v = ::aie::zeros<int32_t, PARALLEL_FACTOR_32b>();
+        for (int y = 0; y < std::min(R, (int)image_height); y++) v = ::aie::add(v, box_widen(in + y * image_width + j));
+        ::aie::store_v(col_sum + j, v);
+    }
+    for (int k = 0; k < PAD; k += 8) ::aie::store_v(prefix + k, ::aie::zeros<int32_t, 8>());
+
+    for (int i = 0; i < image_height; i++) {
+        // Row i + R enters the window, row i - R - 1 leaves it
+        const int16* restrict enter = in + std::min(i + R, image_height - 1) * image_width;
+        const int16* restrict leave = in + std::max(i - R - 1, 0) * image_width;
+        const bool has_enter = (i + R < image_height);
+        const bool has_leave = (i - R - 1 >= 0);
+
+        int32_t carry = 0;
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_32b) chess_prepare_for_pipelining {
+                ::aie::vector<int32_t, PARALLEL_FACTOR_32b> v = ::aie::load_v<PARALLEL_FACTOR_32b>(col_sum + j);
+                if (has_enter) v = ::aie::add(v, box_widen(enter + j));
+                if (has_leave) v = ::aie::sub(v, box_widen(leave + j));
+                ::aie::store_v(col_sum + j, v);
+                v = ::aie::add(integral_scan(v), carry);
+                carry = v[PARALLEL_FACTOR_32b - 1];
+                ::aie::store_v(sat_row + j, v);
+            }
+        const ::aie::vector<int32_t, 8> last = ::aie::broadcast<int32_t, 8>(sat_row[image_width - 1]);
+        for (int k = 0; k < PAD; k += 8) ::aie::store_v(sat_row + image_width + k, last);
+
+        const int16_t row_recip =
+            box_recip(std::min(i + R, image_height - 1) - std::max(i - R, 0) + 1, row_exp);
+
+        for (int j = 0; j < image_width; j += PARALLEL_FACTOR_32b) chess_prepare_for_pipelining {
+                ::aie::vector<int32_t, PARALLEL_FACTOR_32b> sum =
+                    ::aie::sub(box_load_at(sat_row, j + R), box_load_at(sat_row, j - R - 1));
+
+                // mean = sum / rows / columns
+                ::aie::accum<acc80, PARALLEL_FACTOR_32b> acc =
+                    ::aie::mul(sum, ::aie::broadcast<int16_t, PARALLEL_FACTOR_32b>(row_recip));
+                ::aie::vector<int32_t, PARALLEL_FACTOR_32b> q =
+                    acc.template to_vector<int32_t>(14 + row_exp - FRAC_BITS);
+                acc.from_vector(bias, 0);
+                acc = ::aie::mac(acc, q, ::aie::load_v<PARALLEL_FACTOR_32b>(col_recip + j));
+                *(ptr_out++) = acc.template to_vector<int16_t>(14 + col_exp + FRAC_BITS);
+            }
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_filter2d_16b_aie.hpp"
+
+#ifndef _AIE_LOG_16B_H_
+#define _AIE_LOG_16B_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+/**
+ * Rows i-2 .. i+2 of the 5x5 LoG for one 16 pixel output vector. Mirrored
+ * rows are pre-added and the mirrored columns go through the pre-adder of
+ * the symmetric MAC, k[dy] = {L(dy, 2), L(dy, 1), L(dy, 0)}.
+ */
+template <bool LEFT, bool RIGHT>
+inline v16int16 log_k5_block(const int16* const* row,
+                             const int j,
+                             const int16_t image_width,
+                             const ::aie::vector<int16_t, 16> (&k)[3],
+                             const int shift) {
+    ::aie::vector<int16_t, 32> d[5];
+    for (int r = 0; r < 5; r++) chess_unroll_loop(*) {
+            d[r] = filter2D_load_row_border<LEFT, RIGHT>(row[r], j, image_width);
+        }
+
+    // d[j - 2] sits at index 6 of the row buffers
+    ::aie::accum<acc48, PARALLEL_FACTOR_16b> acc =
+        ::aie::sliding_mul_sym<PARALLEL_FACTOR_16b, 5>(k[2], 0, ::aie::add(d[0], d[4]), 6);
+    acc = ::aie::sliding_mac_sym<PARALLEL_FACTOR_16b, 5>(acc, k[1], 0, ::aie::add(d[1], d[3]), 6);
+    acc = ::aie::sliding_mac_sym<PARALLEL_FACTOR_16b, 5>(acc, k[0], 0, d[2], 6);
+    return acc.template to_vector<int16_t>(shift);
+}
+
+/**
+ * 16-bit Laplacian of Gaussian (5x5) with border effect handling
+ *
+ * The Gaussian and the Laplacian are fused into one 5x5 kernel, symmetric
+ * about both axes, so only its 9 unique values are passed:
+ *
+ *   coeff[3 * dy + dx] = L(dy, dx), dy, dx = 0 .. 2 (distance to the centre)
+ *
+ * (see logCoeffK5 for a runtime sigma). The response is signed and
+ * saturated to int16 (the kernel sets the saturation mode itself), the
+ * output metadata is flagged accordingly. Mirrored rows and then mirrored
+ * columns are pre-added in int16, the corner taps see the sum of four
+ * pixels, so pixel data is limited to 14 bits (filter2d_check -m log5 models
+ * the pre-adders and reports inputs that break this). Borders are
+ * replicated, tiles need an overlap of 2 and metadata is copied to the
+ * output tile.
+ */
+__attribute__((noinline)) void log_k5_border(input_window_int16* img_in,
+                                             const int16_t (&coeff)[16],
+                                             output_window_int16* img_out,
+                                             const int shift) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+    xfSignedSaturation(img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    ::aie::vector<int16_t, 16> k[3];
+    for (int dy = 0; dy < 3; dy++) chess_unroll_loop(*) {
+            k[dy] = ::aie::zeros<int16_t, 16>();
+            k[dy][0] = coeff[3 * dy + 2];
+            k[dy][1] = coeff[3 * dy + 1];
+            k[dy][2] = coeff[3 * dy];
+        }
+
+    set_sat();
+    for (int i = 0; i < image_height; i++) {
+        const int16* row[5];
+        for (int r = 0; r < 5; r++) chess_unroll_loop(*) {
+                row[r] = ptr_img_buffer + std::min(std::max(i + r - 2, 0), image_height - 1) * stride;
+            }
+
+        // Left border
+        *(ptr_out++) = log_k5_block<true, false>(row, 0, image_width, k, shift);
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                *(ptr_out++) = log_k5_block<false, false>(row, j, image_width, k, shift);
+            }
+
+        // Right border
+        *(ptr_out++) = log_k5_block<false, true>(row, 0, image_width, k, shift);
+    }
+    clr_sat();
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
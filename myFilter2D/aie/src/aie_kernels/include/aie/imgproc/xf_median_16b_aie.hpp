@@ -0,0 +1,132 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_median_network.hpp"
+#include "xf_filter2d_16b_aie.hpp"
+
+#ifndef _AIE_MEDIAN_16B_H_
+#define _AIE_MEDIAN_16B_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Branch-free compare-exchange: a <- min(a, b), b <- max(a, b), lane-wise
+template <int N>
+inline void median_cmpx(::aie::vector<int16_t, N>& a, ::aie::vector<int16_t, N>& b) {
+    ::aie::vector<int16_t, N> lo = ::aie::min(a, b);
+    b = ::aie::max(a, b);
+    a = lo;
+}
+
+template <bool LEFT, bool RIGHT>
+inline v16int16 median_k3_block(const int16* const* row, const int j, const int16_t image_width) {
+    // Sort the columns of all 32 buffered pixels at once
+    ::aie::vector<int16_t, 32> c0 = filter2D_load_row_border<LEFT, RIGHT>(row[0], j, image_width);
+    ::aie::vector<int16_t, 32> c1 = filter2D_load_row_border<LEFT, RIGHT>(row[1], j, image_width);
+    ::aie::vector<int16_t, 32> c2 = filter2D_load_row_border<LEFT, RIGHT>(row[2], j, image_width);
+    median_cmpx(c1, c2);
+    median_cmpx(c0, c1);
+    median_cmpx(c1, c2);
+
+    // p[3 * c + r]: rank r of column j - 1 + c
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> p[9];
+    for (int c = 0; c < 3; c++) chess_unroll_loop(*) {
+            p[3 * c + 0] = filter2D_tap(c0, c - 1);
+            p[3 * c + 1] = filter2D_tap(c1, c - 1);
+            p[3 * c + 2] = filter2D_tap(c2, c - 1);
+        }
+    for (int n = 0; n < 10; n++) chess_unroll_loop(*) {
+            median_cmpx(p[MEDIAN9_NETWORK[n][0]], p[MEDIAN9_NETWORK[n][1]]);
+        }
+    return p[4];
+}
+
+template <bool LEFT, bool RIGHT>
+inline v16int16 median_k5_block(const int16* const* row, const int j, const int16_t image_width) {
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> p[25];
+    for (int r = 0; r < 5; r++) chess_unroll_loop(*) {
+            ::aie::vector<int16_t, 32> d = filter2D_load_row_border<LEFT, RIGHT>(row[r], j, image_width);
+            for (int c = 0; c < 5; c++) chess_unroll_loop(*) { p[5 * r + c] = filter2D_tap(d, c - 2); }
+        }
+    for (int n = 0; n < 99; n++) chess_unroll_loop(*) {
+            median_cmpx(p[MEDIAN25_NETWORK[n][0]], p[MEDIAN25_NETWORK[n][1]]);
+        }
+    return p[12];
+}
+
+template <int K, bool LEFT, bool RIGHT>
+inline v16int16 median_block(const int16* const* row, const int j, const int16_t image_width) {
+    if (K == 3) return median_k3_block<LEFT, RIGHT>(row, j, image_width);
+    return median_k5_block<LEFT, RIGHT>(row, j, image_width);
+}
+
+/**
+ * 16-bit median (KxK, K = 3 or 5) with border effect handling
+ *
+ * Every output vector runs a branch-free min/max compare-exchange network
+ * over the K*K neighbourhood vectors, 16 pixels per lane group. For 3x3
+ * the columns are pre-sorted on the 32 pixel row buffers, so each column
+ * sort is shared by the three outputs that use it. Borders are replicated
+ * (rows by clamping, columns in the row buffers), tiles need an overlap of
+ * K/2 and metadata is copied to the output tile.
+ */
+template <int K>
+__attribute__((noinline)) void median_border(input_window_int16* img_in, output_window_int16* img_out) {
+    static_assert(K == 3 || K == 5, "Only 3x3 and 5x5 medians are supported");
+    constexpr int R = K / 2;
+
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    for (int i = 0; i < image_height; i++) {
+        const int16* row[K];
+        for (int r = 0; r < K; r++) chess_unroll_loop(*) {
+                row[r] = ptr_img_buffer + std::min(std::max(i + r - R, 0), image_height - 1) * stride;
+            }
+
+        // Left border
+        *(ptr_out++) = median_block<K, true, false>(row, 0, image_width);
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                *(ptr_out++) = median_block<K, false, false>(row, j, image_width);
+            }
+
+        // Right border
+        *(ptr_out++) = median_block<K, false, true>(row, 0, image_width);
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
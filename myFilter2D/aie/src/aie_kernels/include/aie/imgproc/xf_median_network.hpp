@@ -0,0 +1,52 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_MEDIAN_NETWORK_H_
+#define _XF_MEDIAN_NETWORK_H_
+
+// Kept free of AIE headers so the host model (ref/median_model.cpp) checks
+// the very tables median_border runs
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Compare-exchange networks (Devillard, "Fast median search"), only the
+// median output is used, so the compiler drops every half exchange that
+// does not feed it.
+//
+// 3x3: the first 9 exchanges of opt_med9 sort the three columns, they are
+// done once per row buffer (see median_k3_block), this is the remainder.
+static constexpr int MEDIAN9_NETWORK[10][2] = {{0, 3}, {5, 8}, {4, 7}, {3, 6}, {1, 4},
+                                               {2, 5}, {4, 7}, {4, 2}, {6, 4}, {4, 2}};
+
+// 5x5: opt_med25, 99 exchanges
+static constexpr int MEDIAN25_NETWORK[99][2] = {
+    {0, 1}, {3, 4}, {2, 4}, {2, 3}, {6, 7}, {5, 7}, {5, 6}, {9, 10}, {8, 10}, {8, 9}, {12, 13}, {11, 13}, {11, 12},
+    {15, 16}, {14, 16}, {14, 15}, {18, 19}, {17, 19}, {17, 18}, {21, 22}, {20, 22}, {20, 21}, {23, 24}, {2, 5},
+    {3, 6}, {0, 6}, {0, 3}, {4, 7}, {1, 7}, {1, 4}, {11, 14}, {8, 14}, {8, 11}, {12, 15}, {9, 15}, {9, 12},
+    {13, 16}, {10, 16}, {10, 13}, {20, 23}, {17, 23}, {17, 20}, {21, 24}, {18, 24}, {18, 21}, {19, 22}, {8, 17},
+    {9, 18}, {0, 18}, {0, 9}, {10, 19}, {1, 19}, {1, 10}, {11, 20}, {2, 20}, {2, 11}, {12, 21}, {3, 21}, {3, 12},
+    {13, 22}, {4, 22}, {4, 13}, {14, 23}, {5, 23}, {5, 14}, {15, 24}, {6, 24}, {6, 15}, {7, 16}, {7, 19}, {13, 21},
+    {15, 23}, {7, 13}, {7, 15}, {1, 9}, {3, 11}, {5, 17}, {11, 17}, {9, 17}, {4, 10}, {6, 12}, {7, 14}, {4, 6},
+    {4, 7}, {12, 14}, {10, 14}, {6, 7}, {10, 12}, {6, 10}, {6, 17}, {12, 17}, {7, 17}, {7, 10}, {12, 18}, {7, 12},
+    {10, 18}, {12, 20}, {10, 20}, {10, 12}};
+
+} // aie
+} // cv
+} // xf
+
+#endif
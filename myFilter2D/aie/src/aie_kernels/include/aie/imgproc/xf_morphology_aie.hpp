@@ -0,0 +1,161 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+
+#ifndef _AIE_MORPHOLOGY_H_
+#define _AIE_MORPHOLOGY_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+enum MorphOp { MORPH_ERODE = 0, MORPH_DILATE = 1 };
+
+template <int OP, typename T, int N>
+inline ::aie::vector<T, N> morph_op(const ::aie::vector<T, N>& a, const ::aie::vector<T, N>& b) {
+    if (OP == MORPH_ERODE) return ::aie::min(a, b);
+    return ::aie::max(a, b);
+}
+
+/**
+ * Rectangular erosion / dilation (KW x KH) with border effect handling
+ *
+ * The structuring element is separable, the kernel runs a vertical and a
+ * horizontal pass whose cost does not depend on KH and hardly on KW:
+ *
+ * Vertical, van Herk/Gil-Werman: every vector lane is one column. The rows
+ * of the (replicated) tile are split into blocks of KH, per block a forward
+ * running min/max g and a backward running min/max h are kept, and
+ *
+ *   out[i] = op(h[i], g[i + KH - 1])
+ *
+ * i.e. 3 min/max per output vector for any KH. The result goes straight to
+ * the output tile, one VECTORIZATION_FACTOR wide column strip at a time.
+ *
+ * Horizontal: pixels of a row sit in neighbouring lanes, where a running
+ * min/max would serialise, so the window is built by doubling instead
+ * (op over 1, 2, 4, ... shifted copies), ceil(log2(KW)) + 1 operations per
+ * output vector. This pass runs in place on the output tile.
+ *
+ * Tile geometry comes from the metadata like erode_rect_3x3_api, borders
+ * are replicated, the tiler overlap must be max(KW, KH) / 2. KW is limited
+ * to VECTORIZATION_FACTOR + 1, the tile to MAX_W x MAX_H.
+ */
+template <int OP, typename T, int VECTORIZATION_FACTOR, int KW, int KH, int MAX_W = 256, int MAX_H = 64>
+void morphology_rect_api(input_window<T>* img_in, output_window<T>* img_out) {
+    static_assert(KW % 2 == 1 && KH % 2 == 1, "Structuring element sizes must be odd");
+    static_assert(KW <= VECTORIZATION_FACTOR + 1, "KW is limited by the horizontal window");
+    constexpr int N = VECTORIZATION_FACTOR;
+    constexpr int HALF = N / 2;
+    constexpr int RW = KW / 2;
+    constexpr int RH = KH / 2;
+    constexpr int MAX_ROWS = ((MAX_H + 2 * RH + KH - 1) / KH) * KH;
+
+    alignas(32) static T g[MAX_ROWS][N];
+    alignas(32) static T h[MAX_ROWS][N];
+    alignas(32) static T line[N + MAX_W + N];
+
+    T* img_in_ptr = (T*)img_in->ptr;
+    T* img_out_ptr = (T*)img_out->ptr;
+
+    const int16_t img_width = xfGetTileWidth(img_in_ptr);
+    const int16_t img_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    T* restrict _input = (T*)xfGetImgDataPtr(img_in_ptr);
+    T* restrict _res = (T*)xfGetImgDataPtr(img_out_ptr);
+
+    // Replicated rows -RH .. img_height - 1 + RH, padded to whole blocks
+    const int rows = ((img_height + 2 * RH + KH - 1) / KH) * KH;
+
+    //@Vertical pass (van Herk/Gil-Werman) {
+    for (int x = 0; x < img_width; x += N) {
+        for (int b = 0; b < rows; b += KH) {
+            // forward: g[v] = op(d[b] .. d[v])
+            ::aie::vector<T, N> acc =
+                ::aie::load_v<N>(_input + std::min(std::max(b - RH, 0), img_height - 1) * img_width + x);
+            ::aie::store_v(g[b], acc);
+            for (int v = b + 1; v < b + KH; v++) chess_prepare_for_pipelining {
+                    acc = morph_op<OP>(
+                        acc, ::aie::load_v<N>(_input + std::min(std::max(v - RH, 0), img_height - 1) * img_width + x));
+                    ::aie::store_v(g[v], acc);
+                }
+
+            // backward: h[v] = op(d[v] .. d[b + KH - 1])
+            acc = ::aie::load_v<N>(_input + std::min(std::max(b + KH - 1 - RH, 0), img_height - 1) * img_width + x);
+            ::aie::store_v(h[b + KH - 1], acc);
+            for (int v = b + KH - 2; v >= b; v--) chess_prepare_for_pipelining {
+                    acc = morph_op<OP>(
+                        acc, ::aie::load_v<N>(_input + std::min(std::max(v - RH, 0), img_height - 1) * img_width + x));
+                    ::aie::store_v(h[v], acc);
+                }
+        }
+
+        T* restrict out = _res + x;
+        for (int i = 0; i < img_height; i++) chess_prepare_for_pipelining {
+                ::aie::store_v(out, morph_op<OP>(::aie::load_v<N>(h[i]), ::aie::load_v<N>(g[i + KH - 1])));
+                out += img_width;
+            }
+    }
+    //@}
+
+    //@Horizontal pass (doubling), in place {
+    T* restrict line_data = line + N;
+    for (int i = 0; i < img_height; i++) {
+        T* restrict row = _res + i * img_width;
+        for (int x = 0; x < img_width; x += N) chess_prepare_for_pipelining {
+                ::aie::store_v(line_data + x, ::aie::load_v<N>(row + x));
+            }
+        ::aie::store_v(line_data - HALF, ::aie::broadcast<T, HALF>(line_data[0]));
+        ::aie::store_v(line_data + img_width, ::aie::broadcast<T, HALF>(line_data[img_width - 1]));
+
+        for (int x = 0; x < img_width; x += N) chess_prepare_for_pipelining {
+                // d[x-HALF]++d[x+N+HALF-1], line_data + x - HALF is only HALF aligned
+                const T* restrict p = line_data + x - HALF;
+                ::aie::vector<T, 2 * N> d = ::aie::concat(::aie::load_v<HALF>(p), ::aie::load_v<HALF>(p + HALF),
+                                                          ::aie::load_v<HALF>(p + N),
+                                                          ::aie::load_v<HALF>(p + N + HALF));
+                // m[t] = op(d[t] .. d[t + span - 1])
+                int span = 1;
+                for (; 2 * span <= KW; span *= 2) chess_unroll_loop(*) {
+                        d = morph_op<OP>(d, ::aie::shuffle_down(d, span));
+                    }
+                if (span < KW) d = morph_op<OP>(d, ::aie::shuffle_down(d, KW - span));
+                // lane t of the output starts its window at pixel x + t - RW
+                ::aie::store_v(row + x, ::aie::shuffle_down(d, HALF - RW).template extract<N>(0));
+            }
+    }
+    //@}
+}
+
+/**
+ * Dilation counterpart of erode_rect_3x3_api
+ */
+template <typename T, int VECTORIZATION_FACTOR>
+void dilate_rect_3x3_api(input_window<T>* img_in, output_window<T>* img_out) {
+    morphology_rect_api<MORPH_DILATE, T, VECTORIZATION_FACTOR, 3, 3>(img_in, img_out);
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_resize_bilinear_aie.hpp"
+
+#ifndef _AIE_RESIZE_AREA_H_
+#define _AIE_RESIZE_AREA_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Fractional bits of the vertically averaged row (RGBA int16 per channel)
+static constexpr int RESIZE_AREA_ROW_FRAC_BITS = 7;
+
+// Overlap in Q16 of the unit cell [c, c + 1) with the footprint [s0, s1)
+template <int N>
+inline ::aie::vector<int32_t, N> resize_area_cover(const ::aie::vector<int32_t, N>& c,
+                                                   const ::aie::vector<int32_t, N>& s0,
+                                                   const ::aie::vector<int32_t, N>& s1) {
+    ::aie::vector<int32_t, N> lo = ::aie::max(::aie::upshift(c, RESIZE_SCALE_BITS), s0);
+    ::aie::vector<int32_t, N> hi = ::aie::min(::aie::upshift(::aie::add(c, (int32_t)1), RESIZE_SCALE_BITS), s1);
+    return ::aie::max(::aie::sub(hi, lo), (int32_t)0);
+}
+
+/**
+ * Area (INTER_AREA) downscale of RGBA (4 x uint8) images with a runtime
+ * scale, for ratios scale_x, scale_y >= 1 (input / output size in Q16).
+ *
+ * Same per output row contract as resize_bilinear_rgba: the tile holds
+ * xfGetTileHeight source rows starting at xfGetTilePosV for output row
+ * xfGetTileOutPosV. The footprint spans up to ceil(scale_y) + 1 rows, so
+ * the tiler has to run with that many rows per output row (resizeAreaRows,
+ * xfcvDataMoverParams::mResizeRows), at most MAX_ROWS. Each output pixel is
+ * the mean of its source footprint, pixels partly covered are weighted by
+ * their coverage:
+ *
+ *   - vertical pass: the covered rows are accumulated with Q15 weights
+ *     (coverage / total row coverage) into a row of int16 channels with
+ *     RESIZE_AREA_ROW_FRAC_BITS fractional bits
+ *   - horizontal pass: 4 output pixels (16 channels) per vector, for each
+ *     of the ceil(scale_x) + 1 taps the column and its coverage come from
+ *     vector arithmetic on the Q16 footprints, weights coverage / scale_x
+ *
+ * Input and output widths must be multiples of 4 pixels, input widths fit
+ * MAX_W: resizeAreaRows rejects wider images on the host, the kernel
+ * clamps the width so row_avg is never overrun.
+ */
+template <int MAX_W, int MAX_ROWS>
+__attribute__((noinline)) void resize_area_rgba(input_window_uint8* img_in,
+                                                output_window_uint8* img_out,
+                                                const int scale_x,
+                                                const int scale_y) {
+    alignas(32) static int16_t row_avg[MAX_W * 4];
+
+    uint8_t* restrict img_in_ptr = (uint8_t*)img_in->ptr;
+    uint8_t* restrict img_out_ptr = (uint8_t*)img_out->ptr;
+
+    const int16_t width_in = std::min((int)xfGetTileWidth(img_in_ptr), MAX_W);
+    const int16_t height_in = xfGetTileHeight(img_in_ptr);
+    const int16_t width_out = xfGetTileOutTWidth(img_in_ptr);
+    const int16_t row_out = xfGetTileOutPosV(img_in_ptr);
+    const int16_t row_in = xfGetTilePosV(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    const uint8_t* restrict ptr_in = (const uint8_t*)xfGetImgDataPtr(img_in_ptr);
+    uint8_t* restrict ptr_out = (uint8_t*)xfGetImgDataPtr(img_out_ptr);
+
+    // Vertical pass: row weights from the coverage (Q8) of the footprint [y0, y1)
+    const int32_t y0 = row_out * scale_y;
+    const int32_t y1 = y0 + scale_y;
+    const int rows = std::min((int)height_in, MAX_ROWS);
+    int32_t cover[MAX_ROWS];
+    int32_t cover_sum = 0;
+    for (int r = 0; r < rows; r++) {
+        const int32_t c0 = (row_in + r) << RESIZE_SCALE_BITS;
+        cover[r] = std::max(std::min(c0 + (1 << RESIZE_SCALE_BITS), y1) - std::max(c0, y0), 0) >> 8;
+        cover_sum += cover[r];
+    }
+    int16_t w_row[MAX_ROWS];
+    for (int r = 0; r < rows; r++) w_row[r] = (int16_t)std::min((cover[r] << 15) / std::max(cover_sum, 1), 32767);
+
+    const int channels_in = width_in * 4;
+    for (int x = 0; x < channels_in; x += 16) chess_prepare_for_pipelining {
+            ::aie::accum<acc48, 16> acc = ::aie::zeros<acc48, 16>();
+            for (int r = 0; r < rows; r++) {
+                ::aie::vector<uint8_t, 16> d = ::aie::load_v<16>(ptr_in + r * channels_in + x);
+                acc = ::aie::mac(acc, d.unpack().template cast_to<int16_t>(), w_row[r]);
+            }
+            ::aie::store_v(row_avg + x, acc.template to_vector<int16_t>(15 - RESIZE_AREA_ROW_FRAC_BITS));
+        }
+
+    // Horizontal pass, lane 4 * k + c holds channel c of output pixel k
+    const int taps = ((scale_x + (1 << RESIZE_SCALE_BITS) - 1) >> RESIZE_SCALE_BITS) + 1;
+    const int16_t inv_scale = (int16_t)std::min((1u << (15 + RESIZE_SCALE_BITS)) / (unsigned)scale_x, 32767u); // Q15
+    const int32_t s_max = width_in << RESIZE_SCALE_BITS;
+
+    ::aie::vector<int32_t, 16> s0;
+    for (int l = 0; l < 16; l++) chess_unroll_loop(*) { s0[l] = (l / 4) * scale_x; }
+    const int32_t step = 4 * scale_x;
+
+    // Rounding bias of the output
+    const ::aie::vector<int16_t, 16> one = ::aie::broadcast<int16_t, 16>(1);
+
+    for (int o = 0; o < width_out; o += 4) {
+        ::aie::vector<int32_t, 16> s1 = ::aie::min(::aie::add(s0, scale_x), s_max);
+        ::aie::vector<int32_t, 16> c = ::aie::downshift(s0, RESIZE_SCALE_BITS);
+
+        ::aie::accum<acc48, 16> acc;
+        acc.from_vector(one, 15 + RESIZE_AREA_ROW_FRAC_BITS - 1);
+        for (int t = 0; t < taps; t++) chess_prepare_for_pipelining {
+                // Coverage in Q8, weight coverage / scale_x in Q15
+                ::aie::accum<acc48, 16> cv;
+                cv.from_vector(resize_area_cover(c, s0, s1), 0);
+                ::aie::vector<int16_t, 16> w =
+                    ::aie::mul(cv.template to_vector<int16_t>(RESIZE_SCALE_BITS - 8), inv_scale)
+                        .template to_vector<int16_t>(8);
+
+                ::aie::vector<int16_t, 16> d;
+                for (int k = 0; k < 4; k++) chess_unroll_loop(*) {
+                        const int x = std::min((int)c[4 * k], width_in - 1);
+                        d.insert(k, ::aie::load_v<4>(row_avg + 4 * x));
+                    }
+                acc = ::aie::mac(acc, d, w);
+                c = ::aie::add(c, (int32_t)1);
+            }
+        ::aie::store_v(ptr_out, acc.template to_vector<uint8_t>(15 + RESIZE_AREA_ROW_FRAC_BITS));
+        ptr_out += 16;
+        s0 = ::aie::add(s0, step);
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_resize_bilinear_aie.hpp"
+
+#ifndef _AIE_RESIZE_BICUBIC_H_
+#define _AIE_RESIZE_BICUBIC_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+static constexpr int RESIZE_CUBIC_PHASE_BITS = 6;  // sub-pixel phases of the coefficient LUT
+static constexpr int RESIZE_CUBIC_COEFF_BITS = 14; // Q14 taps, each phase sums to 1 << 14
+static constexpr int RESIZE_CUBIC_ROW_FRAC_BITS = 6; // vertical pass output, int16 per channel
+static constexpr int RESIZE_CUBIC_PHASES = 1 << RESIZE_CUBIC_PHASE_BITS;
+
+/**
+ * Keys cubic (a = -0.75, as cv::INTER_CUBIC) taps for source pixels
+ * floor(s) - 1 .. floor(s) + 2 of every phase, each tap replicated over the
+ * 4 channels so the horizontal pass loads them as vectors:
+ *
+ *   lut[(phase * 4 + tap) * 4 + channel]
+ */
+inline void resize_cubic_lut(int16_t* lut) {
+    const float a = -0.75f;
+    for (int p = 0; p < RESIZE_CUBIC_PHASES; p++) {
+        const float f = (float)p / RESIZE_CUBIC_PHASES;
+        float w[4];
+        w[0] = ((a * (f + 1.0f) - 5.0f * a) * (f + 1.0f) + 8.0f * a) * (f + 1.0f) - 4.0f * a;
+        w[1] = ((a + 2.0f) * f - (a + 3.0f)) * f * f + 1.0f;
+        w[2] = ((a + 2.0f) * (1.0f - f) - (a + 3.0f)) * (1.0f - f) * (1.0f - f) + 1.0f;
+        w[3] = 1.0f - w[0] - w[1] - w[2];
+
+        int16_t q[4];
+        int sum = 0;
+        for (int t = 0; t < 4; t++) {
+            q[t] = (int16_t)(w[t] * (1 << RESIZE_CUBIC_COEFF_BITS) + (w[t] < 0.0f ? -0.5f : 0.5f));
+            sum += q[t];
+        }
+        q[(f < 0.5f) ? 1 : 2] += (int16_t)((1 << RESIZE_CUBIC_COEFF_BITS) - sum);
+
+        for (int t = 0; t < 4; t++)
+            for (int c = 0; c < 4; c++) lut[(p * 4 + t) * 4 + c] = q[t];
+    }
+}
+
+/**
+ * Bicubic resize of RGBA (4 x uint8) images with a runtime scale
+ *
+ * Same per output row contract as resize_bilinear_rgba, with the four
+ * source rows floor(sy) - 1 .. floor(sy) + 2 of output row xfGetTileOutPosV
+ * in the tile (starting at xfGetTilePosV, rows outside the tile are
+ * replicated from its edges), so the tiler has to run with four rows per
+ * output row (resizeCubicRows, xfcvDataMoverParams::mResizeRows). The
+ * filter runs as two separable passes:
+ *
+ *   - vertical: the 4 rows are combined with the taps of the row phase into
+ *     an int16 row with RESIZE_CUBIC_ROW_FRAC_BITS fractional bits
+ *   - horizontal: 4 output pixels (16 channels) per vector, Q16 source
+ *     positions stepped by 4 * scale_x, the phase of each pixel selects its
+ *     4 taps in the coefficient LUT
+ *
+ * The LUT (2 KB of tile memory) holds RESIZE_CUBIC_PHASES phases and is
+ * built on the first call, so any scale works without host tables. Over /
+ * undershoots of the negative taps saturate to uint8 (set_sat). Input and
+ * output widths must be multiples of 4 pixels, input widths fit MAX_W:
+ * resizeCubicRows rejects wider images on the host, the kernel clamps the
+ * width so row_v is never overrun.
+ */
+template <int MAX_W>
+__attribute__((noinline)) void resize_bicubic_rgba(input_window_uint8* img_in,
+                                                   output_window_uint8* img_out,
+                                                   const int scale_x,
+                                                   const int scale_y) {
+    alignas(32) static int16_t lut[RESIZE_CUBIC_PHASES * 4 * 4];
+    alignas(32) static int16_t row_v[MAX_W * 4];
+    static bool lut_init = false;
+    if (!lut_init) {
+        resize_cubic_lut(lut);
+        lut_init = true;
+    }
+
+    uint8_t* restrict img_in_ptr = (uint8_t*)img_in->ptr;
+    uint8_t* restrict img_out_ptr = (uint8_t*)img_out->ptr;
+
+    const int16_t width_in = std::min((int)xfGetTileWidth(img_in_ptr), MAX_W);
+    const int16_t height_in = xfGetTileHeight(img_in_ptr);
+    const int16_t width_out = xfGetTileOutTWidth(img_in_ptr);
+    const int16_t row_out = xfGetTileOutPosV(img_in_ptr);
+    const int16_t row_in = xfGetTilePosV(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    const uint8_t* restrict ptr_in = (const uint8_t*)xfGetImgDataPtr(img_in_ptr);
+    uint8_t* restrict ptr_out = (uint8_t*)xfGetImgDataPtr(img_out_ptr);
+    const int channels_in = width_in * 4;
+
+    set_sat();
+
+    // Vertical pass
+    const int32_t py = resize_src_pos(row_out, scale_y);
+    const int iy = py >> RESIZE_SCALE_BITS; // floor, py may be negative
+    const int phase_y = (py - (iy << RESIZE_SCALE_BITS)) >> (RESIZE_SCALE_BITS - RESIZE_CUBIC_PHASE_BITS);
+    const uint8_t* row[4];
+    int16_t wy[4];
+    for (int t = 0; t < 4; t++) chess_unroll_loop(*) {
+            row[t] = ptr_in + std::min(std::max(iy - 1 + t - row_in, 0), height_in - 1) * channels_in;
+            wy[t] = lut[(phase_y * 4 + t) * 4];
+        }
+
+    for (int x = 0; x < channels_in; x += 16) chess_prepare_for_pipelining {
+            ::aie::accum<acc48, 16> acc = ::aie::zeros<acc48, 16>();
+            for (int t = 0; t < 4; t++) chess_unroll_loop(*) {
+                    ::aie::vector<uint8_t, 16> d = ::aie::load_v<16>(row[t] + x);
+                    acc = ::aie::mac(acc, d.unpack().template cast_to<int16_t>(), wy[t]);
+                }
+            ::aie::store_v(row_v + x,
+                           acc.template to_vector<int16_t>(RESIZE_CUBIC_COEFF_BITS - RESIZE_CUBIC_ROW_FRAC_BITS));
+        }
+
+    // Horizontal pass, lane 4 * k + c holds channel c of output pixel k
+    constexpr int OUT_SHIFT = RESIZE_CUBIC_COEFF_BITS + RESIZE_CUBIC_ROW_FRAC_BITS;
+    const ::aie::vector<int16_t, 16> one = ::aie::broadcast<int16_t, 16>(1);
+
+    ::aie::vector<int32_t, 16> px;
+    for (int l = 0; l < 16; l++) chess_unroll_loop(*) { px[l] = resize_src_pos(l / 4, scale_x); }
+    const int32_t step = 4 * scale_x;
+
+    for (int o = 0; o < width_out; o += 4) chess_prepare_for_pipelining chess_loop_range(4, ) {
+            ::aie::vector<int32_t, 16> ix = ::aie::downshift(px, RESIZE_SCALE_BITS);
+            ::aie::vector<int32_t, 16> phase = ::aie::downshift(
+                ::aie::sub(px, ::aie::upshift(ix, RESIZE_SCALE_BITS)), RESIZE_SCALE_BITS - RESIZE_CUBIC_PHASE_BITS);
+            px = ::aie::add(px, step);
+
+            ::aie::accum<acc48, 16> acc;
+            acc.from_vector(one, OUT_SHIFT - 1);
+            for (int t = 0; t < 4; t++) chess_unroll_loop(*) {
+                    ::aie::vector<int16_t, 16> d;
+                    ::aie::vector<int16_t, 16> w;
+                    for (int k = 0; k < 4; k++) chess_unroll_loop(*) {
+                            const int x = std::min(std::max((int)ix[4 * k] - 1 + t, 0), width_in - 1);
+                            d.insert(k, ::aie::load_v<4>(row_v + 4 * x));
+                            w.insert(k, ::aie::load_v<4>(lut + ((int)phase[4 * k] * 4 + t) * 4));
+                        }
+                    acc = ::aie::mac(acc, d, w);
+                }
+            ::aie::store_v(ptr_out, acc.template to_vector<uint8_t>(OUT_SHIFT));
+            ptr_out += 16;
+        }
+    clr_sat();
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+
+#ifndef _AIE_RESIZE_BILINEAR_H_
+#define _AIE_RESIZE_BILINEAR_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Source positions and interpolation weights are fixed point
+static constexpr int RESIZE_SCALE_BITS = 16;  // scale and source positions
+static constexpr int RESIZE_WEIGHT_BITS = 8;  // interpolation weights, 256 == 1.0
+
+// Source coordinate (Q16) of output pixel 'o', pixel centres aligned:
+// s = (o + 0.5) * scale - 0.5
+inline int32_t resize_src_pos(const int o, const int32_t scale) {
+    return o * scale + (scale >> 1) - (1 << (RESIZE_SCALE_BITS - 1));
+}
+
+/**
+ * Integer source pixel and weight of the next pixel for the Q16 source
+ * positions 'p': p is clamped to [0, last], the pixel index to
+ * [0, last - 1], so the last pixel gets weight 1 on its right neighbour.
+ */
+template <int N>
+inline void resize_bilinear_split(const ::aie::vector<int32_t, N>& p,
+                                  const int last,
+                                  ::aie::vector<int32_t, N>& idx,
+                                  ::aie::vector<int16_t, N>& frac) {
+    ::aie::vector<int32_t, N> pc =
+        ::aie::min(::aie::max(p, (int32_t)0), (int32_t)(last << RESIZE_SCALE_BITS));
+    idx = ::aie::min(::aie::downshift(pc, RESIZE_SCALE_BITS), (int32_t)std::max(last - 1, 0));
+    ::aie::accum<acc48, N> f;
+    f.from_vector(::aie::sub(pc, ::aie::upshift(idx, RESIZE_SCALE_BITS)), 0);
+    frac = f.template to_vector<int16_t>(RESIZE_SCALE_BITS - RESIZE_WEIGHT_BITS);
+}
+
+// Q8 weight of the second source row of output row 'row_out', relative to
+// the first row of the tile
+inline int16_t resize_bilinear_wy(const int row_out, const int row_in, const int height_in, const int32_t scale_y) {
+    const int32_t py = resize_src_pos(row_out, scale_y) - (row_in << RESIZE_SCALE_BITS);
+    return (int16_t)(std::min(std::max(py, 0), (height_in > 1) ? (1 << RESIZE_SCALE_BITS) : 0) >>
+                     (RESIZE_SCALE_BITS - RESIZE_WEIGHT_BITS));
+}
+
+/**
+ * 4 RGBA output pixels (lane 4 * k + c holds channel c of pixel k) from
+ * the rows 'top' / 'bottom' for the Q16 source positions 'px'.
+ */
+inline ::aie::vector<uint8_t, 16> resize_bilinear_4px(const int32* restrict top,
+                                                      const int32* restrict bottom,
+                                                      const ::aie::vector<int32_t, 16>& px,
+                                                      const int16_t width_in,
+                                                      const int16_t wy0,
+                                                      const int16_t wy1) {
+    ::aie::vector<int32_t, 16> idx;
+    ::aie::vector<int16_t, 16> wx1;
+    resize_bilinear_split(px, width_in - 1, idx, wx1);
+
+    // a b (top) c d (bottom) neighbours of the 4 output pixels
+    ::aie::vector<int32, 16> g;
+    for (int k = 0; k < 4; k++) chess_unroll_loop(*) {
+            const int x = idx[4 * k];
+            g[k] = top[x];
+            g[k + 4] = top[x + 1];
+            g[k + 8] = bottom[x];
+            g[k + 12] = bottom[x + 1];
+        }
+    ::aie::vector<uint8_t, 64> g8 = g.template cast_to<uint8_t>();
+
+    // Q8 2D weights, w11 takes the rounding so they sum to exactly 1
+    ::aie::vector<int16_t, 16> wx0 = ::aie::sub((int16_t)(1 << RESIZE_WEIGHT_BITS), wx1);
+    ::aie::vector<int16_t, 16> w00 = ::aie::mul(wx0, wy0).template to_vector<int16_t>(RESIZE_WEIGHT_BITS);
+    ::aie::vector<int16_t, 16> w01 = ::aie::mul(wx1, wy0).template to_vector<int16_t>(RESIZE_WEIGHT_BITS);
+    ::aie::vector<int16_t, 16> w10 = ::aie::mul(wx0, wy1).template to_vector<int16_t>(RESIZE_WEIGHT_BITS);
+    ::aie::vector<int16_t, 16> w11 =
+        ::aie::sub(::aie::sub(::aie::sub((int16_t)(1 << RESIZE_WEIGHT_BITS), w00), w01), w10);
+
+    ::aie::accum<acc48, 16> acc = ::aie::mul(g8.template extract<16>(0).unpack().template cast_to<int16_t>(), w00);
+    acc = ::aie::mac(acc, g8.template extract<16>(1).unpack().template cast_to<int16_t>(), w01);
+    acc = ::aie::mac(acc, g8.template extract<16>(2).unpack().template cast_to<int16_t>(), w10);
+    acc = ::aie::mac(acc, g8.template extract<16>(3).unpack().template cast_to<int16_t>(), w11);
+    return acc.template to_vector<uint8_t>(RESIZE_WEIGHT_BITS);
+}
+
+/**
+ * Bilinear resize of RGBA (4 x uint8) images with a runtime scale
+ *
+ * Works on the per output row contract of Resize::runImpl: the resize
+ * tiler sends the two source rows of output row xfGetTileOutPosV, starting
+ * at source row xfGetTilePosV, and expects xfGetTileOutTWidth output pixels
+ * back. Instead of host built position / weight tables the kernel derives
+ * them from scale_x / scale_y (input / output size in Q16), 16 channels
+ * (4 pixels) at a time: the Q16 source positions advance by 4 * scale_x
+ * per vector and are split into pixel index and weight with vector min /
+ * max / shifts. Only the four pixel fetches per output pixel are scalar.
+ * Output widths must be multiples of 4 pixels.
+ */
+__attribute__((noinline)) void resize_bilinear_rgba(input_window_uint8* img_in,
+                                                    output_window_uint8* img_out,
+                                                    const int scale_x,
+                                                    const int scale_y) {
+    uint8_t* restrict img_in_ptr = (uint8_t*)img_in->ptr;
+    uint8_t* restrict img_out_ptr = (uint8_t*)img_out->ptr;
+
+    const int16_t width_in = xfGetTileWidth(img_in_ptr);
+    const int16_t height_in = xfGetTileHeight(img_in_ptr);
+    const int16_t width_out = xfGetTileOutTWidth(img_in_ptr);
+
+    const int16_t wy1 = resize_bilinear_wy(xfGetTileOutPosV(img_in_ptr), xfGetTilePosV(img_in_ptr), height_in, scale_y);
+    const int16_t wy0 = (1 << RESIZE_WEIGHT_BITS) - wy1;
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    const int32* restrict top = (const int32*)xfGetImgDataPtr(img_in_ptr);
+    const int32* restrict bottom = top + ((height_in > 1) ? width_in : 0);
+    uint8_t* restrict ptr_out = (uint8_t*)xfGetImgDataPtr(img_out_ptr);
+
+    ::aie::vector<int32_t, 16> px;
+    for (int l = 0; l < 16; l++) chess_unroll_loop(*) { px[l] = resize_src_pos(l / 4, scale_x); }
+    const int32_t step = 4 * scale_x;
+
+    for (int o = 0; o < width_out; o += 4) chess_prepare_for_pipelining chess_loop_range(4, ) {
+            ::aie::store_v(ptr_out, resize_bilinear_4px(top, bottom, px, width_in, wy0, wy1));
+            px = ::aie::add(px, step);
+            ptr_out += 16;
+        }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
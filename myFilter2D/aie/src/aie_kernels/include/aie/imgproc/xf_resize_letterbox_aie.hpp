@@ -0,0 +1,151 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_resize_bilinear_aie.hpp"
+
+#ifndef _AIE_RESIZE_LETTERBOX_H_
+#define _AIE_RESIZE_LETTERBOX_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+// Per channel gain, 16 == 1.0 (same convention as ResizeNorm)
+static constexpr int LETTERBOX_ALPHA_BITS = 4;
+// Pixels per planar output vector, pad_left and content_w are multiples of it
+static constexpr int LETTERBOX_VECTOR = 16;
+
+// (x - mean) * alpha, saturated to int8 (the caller enables set_sat())
+inline ::aie::vector<int8_t, 16> letterbox_normalize(const ::aie::vector<uint8_t, 16>& x,
+                                                     const int16_t mean,
+                                                     const int16_t alpha) {
+    ::aie::vector<int16_t, 16> d = ::aie::sub(x.unpack().template cast_to<int16_t>(), mean);
+    return ::aie::mul(d, alpha).template to_vector<int8_t>(LETTERBOX_ALPHA_BITS);
+}
+
+/**
+ * Letterbox resize of an RGBA (4 x uint8) image into normalized planar
+ * int8 R, G and B outputs, i.e. the CHW input tensor of a detector.
+ *
+ * Same per output row contract and runtime scale as resize_bilinear_rgba,
+ * with the tiler output width being content_w, but each output row is net_w
+ * (the network input width) pixels wide: [0, pad_left) and
+ * [pad_left + content_w, net_w) get the normalized pad_value, the content in
+ * between is the bilinear resize of the source row. The output metadata
+ * carries net_w as tile and final width. 16 pixels are interpolated per iteration (four interleaved RGBA
+ * vectors), de-interleaved with even / odd filters and normalized per
+ * channel as (x - mean[c]) * alpha[c] >> LETTERBOX_ALPHA_BITS. Rows above
+ * and below the content are constant, they are not sent through the tiler.
+ */
+__attribute__((noinline)) void resize_letterbox_chw(input_window_uint8* img_in,
+                                                    output_window_int8* img_out_r,
+                                                    output_window_int8* img_out_g,
+                                                    output_window_int8* img_out_b,
+                                                    const int scale_x,
+                                                    const int scale_y,
+                                                    const int16_t net_w,
+                                                    const int16_t pad_left,
+                                                    const int16_t content_w,
+                                                    const int16_t pad_value,
+                                                    const int16_t* mean,
+                                                    const int16_t* alpha) {
+    uint8_t* restrict img_in_ptr = (uint8_t*)img_in->ptr;
+    int8_t* restrict img_out_ptr[3] = {(int8_t*)img_out_r->ptr, (int8_t*)img_out_g->ptr, (int8_t*)img_out_b->ptr};
+
+    const int16_t width_in = xfGetTileWidth(img_in_ptr);
+    const int16_t height_in = xfGetTileHeight(img_in_ptr);
+
+    const int16_t wy1 = resize_bilinear_wy(xfGetTileOutPosV(img_in_ptr), xfGetTilePosV(img_in_ptr), height_in, scale_y);
+    const int16_t wy0 = (1 << RESIZE_WEIGHT_BITS) - wy1;
+
+    for (int c = 0; c < 3; c++) {
+        xfCopyMetaData(img_in_ptr, img_out_ptr[c]);
+        xfSignedSaturation(img_out_ptr[c]);
+        xfSetTileOutTWidth(img_out_ptr[c], net_w);
+        xfSetTileFinalWidth(img_out_ptr[c], net_w);
+    }
+
+    const int32* restrict top = (const int32*)xfGetImgDataPtr(img_in_ptr);
+    const int32* restrict bottom = top + ((height_in > 1) ? width_in : 0);
+    int8_t* restrict ptr_r = (int8_t*)xfGetImgDataPtr(img_out_ptr[0]);
+    int8_t* restrict ptr_g = (int8_t*)xfGetImgDataPtr(img_out_ptr[1]);
+    int8_t* restrict ptr_b = (int8_t*)xfGetImgDataPtr(img_out_ptr[2]);
+
+    set_sat();
+    const ::aie::vector<uint8_t, 16> pad = ::aie::broadcast<uint8_t, 16>((uint8_t)pad_value);
+    const ::aie::vector<int8_t, 16> pad_r = letterbox_normalize(pad, mean[0], alpha[0]);
+    const ::aie::vector<int8_t, 16> pad_g = letterbox_normalize(pad, mean[1], alpha[1]);
+    const ::aie::vector<int8_t, 16> pad_b = letterbox_normalize(pad, mean[2], alpha[2]);
+
+    // Left band
+    for (int o = 0; o < pad_left; o += LETTERBOX_VECTOR) chess_prepare_for_pipelining {
+            ::aie::store_v(ptr_r, pad_r);
+            ::aie::store_v(ptr_g, pad_g);
+            ::aie::store_v(ptr_b, pad_b);
+            ptr_r += LETTERBOX_VECTOR;
+            ptr_g += LETTERBOX_VECTOR;
+            ptr_b += LETTERBOX_VECTOR;
+        }
+
+    // Content, positions relative to the first content pixel
+    ::aie::vector<int32_t, 16> px;
+    for (int l = 0; l < 16; l++) chess_unroll_loop(*) { px[l] = resize_src_pos(l / 4, scale_x); }
+    const int32_t step = 4 * scale_x;
+
+    for (int o = 0; o < content_w; o += LETTERBOX_VECTOR) chess_prepare_for_pipelining chess_loop_range(1, ) {
+            ::aie::vector<uint8_t, 16> p0 = resize_bilinear_4px(top, bottom, px, width_in, wy0, wy1);
+            px = ::aie::add(px, step);
+            ::aie::vector<uint8_t, 16> p1 = resize_bilinear_4px(top, bottom, px, width_in, wy0, wy1);
+            px = ::aie::add(px, step);
+            ::aie::vector<uint8_t, 16> p2 = resize_bilinear_4px(top, bottom, px, width_in, wy0, wy1);
+            px = ::aie::add(px, step);
+            ::aie::vector<uint8_t, 16> p3 = resize_bilinear_4px(top, bottom, px, width_in, wy0, wy1);
+            px = ::aie::add(px, step);
+
+            // RGBA x 16 -> RB / GA -> R, B, G
+            ::aie::vector<uint8_t, 64> rgba = ::aie::concat(p0, p1, p2, p3);
+            ::aie::vector<uint8_t, 32> rb = ::aie::filter_even(rgba, 1);
+            ::aie::vector<uint8_t, 32> ga = ::aie::filter_odd(rgba, 1);
+
+            ::aie::store_v(ptr_r, letterbox_normalize(::aie::filter_even(rb, 1), mean[0], alpha[0]));
+            ::aie::store_v(ptr_g, letterbox_normalize(::aie::filter_even(ga, 1), mean[1], alpha[1]));
+            ::aie::store_v(ptr_b, letterbox_normalize(::aie::filter_odd(rb, 1), mean[2], alpha[2]));
+            ptr_r += LETTERBOX_VECTOR;
+            ptr_g += LETTERBOX_VECTOR;
+            ptr_b += LETTERBOX_VECTOR;
+        }
+
+    // Right band
+    for (int o = pad_left + content_w; o < net_w; o += LETTERBOX_VECTOR) chess_prepare_for_pipelining {
+            ::aie::store_v(ptr_r, pad_r);
+            ::aie::store_v(ptr_g, pad_g);
+            ::aie::store_v(ptr_b, pad_b);
+            ptr_r += LETTERBOX_VECTOR;
+            ptr_g += LETTERBOX_VECTOR;
+            ptr_b += LETTERBOX_VECTOR;
+        }
+    clr_sat();
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
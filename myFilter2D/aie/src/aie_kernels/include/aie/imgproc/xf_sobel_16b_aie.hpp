@@ -0,0 +1,160 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_filter2d_16b_aie.hpp"
+
+#ifndef _AIE_SOBEL_16B_H_
+#define _AIE_SOBEL_16B_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+enum SobelOutput { SOBEL_DX = 0, SOBEL_DY = 1, SOBEL_L1 = 2 };
+
+/**
+ * 16-bit Sobel gradients (3x3) for one 16 pixel output vector
+ *
+ *   dx:  -a  0  a      dy:  -a -b -a
+ *        -b  0  b            0  0  0
+ *        -a  0  a            a  b  a
+ *
+ * The three input rows are loaded once and feed both accumulators, the
+ * zero middle row of dy is skipped.
+ */
+template <bool LEFT, bool RIGHT>
+inline void sobel_k3_block(const int16* restrict row0,
+                           const int16* restrict row1,
+                           const int16* restrict row2,
+                           const int j,
+                           const int16_t image_width,
+                           const v16int16 (&kx)[2],
+                           const v16int16 (&ky)[2],
+                           v16acc48& gx,
+                           v16acc48& gy) {
+    v32int16 d0 = filter2D_load_row_border<LEFT, RIGHT>(row0, j, image_width);
+    v32int16 d1 = filter2D_load_row_border<LEFT, RIGHT>(row1, j, image_width);
+    v32int16 d2 = filter2D_load_row_border<LEFT, RIGHT>(row2, j, image_width);
+
+    gx = filter2D_kn_mac_row<3>(null_v16acc48(), d0, kx[0]);
+    gx = filter2D_kn_mac_row<3>(gx, d1, kx[1]);
+    gx = filter2D_kn_mac_row<3>(gx, d2, kx[0]);
+
+    gy = filter2D_kn_mac_row<3>(null_v16acc48(), d0, ky[0]);
+    gy = filter2D_kn_mac_row<3>(gy, d2, ky[1]);
+}
+
+/**
+ * Builds the MAC rows {-a, 0, a}, {-b, 0, b} for dx and {-a, -b, -a},
+ * {a, b, a} for dy from the smoothing taps a, b.
+ */
+inline void sobel_k3_coeff(const int16_t a, const int16_t b, v16int16 (&kx)[2], v16int16 (&ky)[2]) {
+    ::aie::vector<int16_t, 16> v = ::aie::zeros<int16_t, 16>();
+    v[0] = -a;
+    v[2] = a;
+    kx[0] = v;
+    v[0] = -b;
+    v[2] = b;
+    kx[1] = v;
+    v[0] = -a;
+    v[1] = -b;
+    v[2] = -a;
+    ky[0] = v;
+    v[0] = a;
+    v[1] = b;
+    v[2] = a;
+    ky[1] = v;
+}
+
+template <int OUTPUT>
+inline v16int16 sobel_k3_output(v16acc48 gx, v16acc48 gy, const int shift) {
+    if (OUTPUT == SOBEL_DX) return srs(gx, shift);
+    if (OUTPUT == SOBEL_DY) return srs(gy, shift);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> dx = srs(gx, shift);
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> dy = srs(gy, shift);
+    return ::aie::add(::aie::abs(dx), ::aie::abs(dy)); // |dx| + |dy|
+}
+
+/**
+ * 16-bit Sobel (3x3) with border effect handling
+ *
+ * OUTPUT selects the output tile: SOBEL_DX, SOBEL_DY (signed gradients,
+ * flagged for signed saturation) or SOBEL_L1 (|dx| + |dy|, flagged for
+ * unsigned saturation). The smoothing taps come from coeff[0] = a and
+ * coeff[1] = b, {1, 2} gives Sobel and {3, 10} Scharr, results are rounded
+ * with 'shift'. Like laplacian_k3_border the tile is split into left border,
+ * middle and right border regions and top / bottom rows are replicated,
+ * metadata is copied to the output tile.
+ */
+template <int OUTPUT>
+__attribute__((noinline)) void sobel_k3_border(input_window_int16* img_in,
+                                               const int16_t (&coeff)[16],
+                                               output_window_int16* img_out,
+                                               const int shift = 0) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+    if (OUTPUT == SOBEL_L1)
+        xfUnsignedSaturation(img_out_ptr);
+    else
+        xfSignedSaturation(img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    v16int16 kx[2];
+    v16int16 ky[2];
+    sobel_k3_coeff(coeff[0], coeff[1], kx, ky);
+
+    v16acc48 gx;
+    v16acc48 gy;
+
+    for (int i = 0; i < image_height; i++) {
+        const int16* restrict row0 = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        const int16* restrict row1 = ptr_img_buffer + i * stride;
+        const int16* restrict row2 = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+
+        // Left border
+        sobel_k3_block<true, false>(row0, row1, row2, 0, image_width, kx, ky, gx, gy);
+        *(ptr_out++) = sobel_k3_output<OUTPUT>(gx, gy, shift);
+
+        // Middle region: border effect free
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                sobel_k3_block<false, false>(row0, row1, row2, j, image_width, kx, ky, gx, gy);
+                *(ptr_out++) = sobel_k3_output<OUTPUT>(gx, gy, shift);
+            }
+
+        // Right border
+        sobel_k3_block<false, true>(row0, row1, row2, 0, image_width, kx, ky, gx, gy);
+        *(ptr_out++) = sobel_k3_output<OUTPUT>(gx, gy, shift);
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
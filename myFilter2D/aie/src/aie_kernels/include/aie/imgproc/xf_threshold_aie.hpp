@@ -73,6 +73,41 @@ __attribute__((noinline)) void threshold(
         }
 }
 
+/**
+ * ----------------------------------------------------------------------------
+ * HLI Double threshold (Canny)
+ * ----------------------------------------------------------------------------
+ * x > high_thresh -> strong_val, low_thresh < x <= high_thresh -> weak_val,
+ * 0 otherwise
+*/
+template <typename T, int N>
+__attribute__((noinline)) void double_threshold(T* img_in,
+                                                T* img_out,
+                                                const T& img_width,
+                                                const T& img_height,
+                                                const T& low_thresh,
+                                                const T& high_thresh,
+                                                const T& weak_val,
+                                                const T& strong_val) {
+    ::aie::vector<T, N> constants;
+    ::aie::vector<T, N> data_out;
+    constants[0] = 0;           // updating constant zero_val value
+    constants[1] = low_thresh;  // updating constant low threshold value
+    constants[2] = high_thresh; // updating constant high threshold value
+    constants[3] = weak_val;    // updating constant weak edge value
+    constants[4] = strong_val;  // updating constant strong edge value
+
+    for (int j = 0; j < (img_height * img_width); j += N) // 32x samples per loop
+        chess_prepare_for_pipelining chess_loop_range(14, ) {
+            ::aie::vector<T, N> data_buf1 = ::aie::load_v(img_in); // in:00++31|_________|_________|_________
+            img_in += N;
+            data_out = ::aie::select(constants[0], constants[3], ::aie::lt(constants[1], data_buf1));
+            data_out = ::aie::select(data_out, constants[4], ::aie::lt(constants[2], data_buf1));
+            ::aie::store_v(img_out, data_out);
+            img_out += N;
+        }
+}
+
 /**
  * ----------------------------------------------------------------------------
  * 16-bit Threshold
@@ -97,6 +132,30 @@ __attribute__((noinline)) void threshold_api(input_window_int16* restrict img_in
     threshold<int16_t, 32>(ptr_in, ptr_out, image_width, image_height, thresh_val, max_val);
 }
 
+/**
+ * ----------------------------------------------------------------------------
+ * 16-bit Double threshold, strong edges 255, weak edges 128
+ * ----------------------------------------------------------------------------
+*/
+
+__attribute__((noinline)) void double_threshold_api(input_window_int16* restrict img_in,
+                                                    output_window_int16* restrict img_out,
+                                                    const int16& low_thresh,
+                                                    const int16& high_thresh) {
+    int16_t* img_in_ptr = (int16_t*)img_in->ptr;
+    int16_t* img_out_ptr = (int16_t*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+
+    int16_t* restrict ptr_in = (int16_t*)xfGetImgDataPtr(img_in_ptr);
+    int16_t* restrict ptr_out = (int16_t*)xfGetImgDataPtr(img_out_ptr);
+
+    double_threshold<int16_t, 32>(ptr_in, ptr_out, image_width, image_height, low_thresh, high_thresh, 128, 255);
+}
+
 } // aie
 } // cv
 } // xf
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <adf.h>
+#include <algorithm>
+#include <aie_api/aie.hpp>
+#include <common/xf_aie_hw_utils.hpp>
+#include "xf_filter2d_16b_aie.hpp"
+
+#ifndef _AIE_UNSHARP_16B_H_
+#define _AIE_UNSHARP_16B_H_
+
+namespace xf {
+namespace cv {
+namespace aie {
+
+/**
+ * 16-bit unsharp mask (3x3) with border effect handling
+ *
+ *   o = src * (1 + a) - blur * a
+ *
+ * The blur uses a 3x3 kernel in the filter2D_k3_border layout rounded with
+ * 'shift' (e.g. gaussianCoeffK3). It never leaves the vector registers: each
+ * 16 pixel blur vector is rounded out of the accumulator and combined with
+ * the source pixels in a second accumulator, without an intermediate tile.
+ * The blur is rounded exactly like gaussian_k3_border, the weighted sum has
+ * UNSHARP_AMOUNT_BITS fractional bits (addweighted's Q1.15 weights cannot
+ * hold 1 + a). ref/filter2d_check -m unsharp models the kernel bit-exactly.
+ * The amount a rides in the otherwise unused coeff[15], in
+ * Q.UNSHARP_AMOUNT_BITS (256 = 1.0), so the kernel keeps the filter2D
+ * ports. Output tiles are flagged for unsigned saturation like addweighted.
+ */
+inline v16int16 unsharp_compute(v16acc48 blur_acc,
+                                v16int16 src,
+                                const int shift,
+                                const int16_t amount,
+                                const int16_t one_plus_amount) {
+    ::aie::vector<int16_t, PARALLEL_FACTOR_16b> blur = srs(blur_acc, shift);
+    ::aie::accum<acc48, PARALLEL_FACTOR_16b> acc =
+        ::aie::mul(::aie::vector<int16_t, PARALLEL_FACTOR_16b>(src), one_plus_amount); // src*(1+a)
+    acc = ::aie::msc(acc, blur, amount);                                               // - blur*a
+    return acc.template to_vector<int16_t>(UNSHARP_AMOUNT_BITS);
+}
+
+__attribute__((noinline)) void unsharp_k3_border(input_window_int16* img_in,
+                                                 const int16_t (&coeff)[16],
+                                                 output_window_int16* img_out,
+                                                 const int shift) {
+    int16* restrict img_in_ptr = (int16*)img_in->ptr;
+    int16* restrict img_out_ptr = (int16*)img_out->ptr;
+
+    const int16_t image_width = xfGetTileWidth(img_in_ptr);
+    const int16_t image_height = xfGetTileHeight(img_in_ptr);
+    const int16_t stride = image_width; // tile rows are packed back to back
+
+    xfCopyMetaData(img_in_ptr, img_out_ptr);
+    xfUnsignedSaturation(img_out_ptr);
+
+    int16* restrict ptr_img_buffer = (int16*)xfGetImgDataPtr(img_in_ptr);
+    v16int16* restrict ptr_out = (v16int16*)xfGetImgDataPtr(img_out_ptr);
+
+    // k0 k1 0 k2 0 k3 k4 0 k5 0 k6 k7 0 k8 0 0 -> one {kr0, kr1, kr2, 0} row
+    // per kernel row for filter2D_kn_mac_row<3>
+    alignas(32) int16_t coeff_rows[3 * 16] = {0};
+    const int k3_index[9] = {0, 1, 3, 5, 6, 8, 10, 11, 13};
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 3; c++) coeff_rows[16 * r + c] = coeff[k3_index[3 * r + c]];
+
+    const int16_t a = coeff[15];
+    const int16_t one_plus_a = (int16_t)((1 << UNSHARP_AMOUNT_BITS) + a);
+
+    v32int16 data_buf;
+    v16acc48 acc;
+
+    for (int i = 0; i < image_height; i++) {
+        int16* restrict row[3];
+        row[0] = ptr_img_buffer + std::max(i - 1, 0) * stride;
+        row[1] = ptr_img_buffer + i * stride;
+        row[2] = ptr_img_buffer + std::min(i + 1, image_height - 1) * stride;
+
+        // **********************************************************************
+        // Left border
+        // **********************************************************************
+        {
+            acc = null_v16acc48();
+            for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+                    data_buf = filter2D_load_row_border<true, false>(row[r], 0, image_width);
+                    acc = filter2D_kn_mac_row<3>(acc, data_buf, *(v16int16*)(coeff_rows + 16 * r));
+                }
+            *(ptr_out++) = unsharp_compute(acc, *(v16int16*)(row[1]), shift, a, one_plus_a);
+        }
+
+        // **********************************************************************
+        // Middle region: border effect free
+        // **********************************************************************
+        for (int j = PARALLEL_FACTOR_16b; j < image_width - PARALLEL_FACTOR_16b; j += PARALLEL_FACTOR_16b)
+            chess_prepare_for_pipelining {
+                acc = null_v16acc48();
+                for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+                        data_buf = filter2D_load_row(row[r] + j - 8);
+                        acc = filter2D_kn_mac_row<3>(acc, data_buf, *(v16int16*)(coeff_rows + 16 * r));
+                    }
+                *(ptr_out++) = unsharp_compute(acc, *(v16int16*)(row[1] + j), shift, a, one_plus_a);
+            }
+
+        // **********************************************************************
+        // Right border
+        // **********************************************************************
+        {
+            acc = null_v16acc48();
+            for (int r = 0; r < 3; r++) chess_unroll_loop(*) {
+                    data_buf =
+                        filter2D_load_row_border<false, true>(row[r], image_width - PARALLEL_FACTOR_16b, image_width);
+                    acc = filter2D_kn_mac_row<3>(acc, data_buf, *(v16int16*)(coeff_rows + 16 * r));
+                }
+            *(ptr_out++) =
+                unsharp_compute(acc, *(v16int16*)(row[1] + image_width - PARALLEL_FACTOR_16b), shift, a, one_plus_a);
+        }
+    }
+}
+
+} // aie
+} // cv
+} // xf
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef _BLOB_PARAMS_H_
+#define _BLOB_PARAMS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// blobFromImage op, same order as xf::cv::aie::ops (runtime parameter 'op'
+// of BlobFromImageGraph)
+enum BlobOp {
+    BLOB_MEAN_SUB = 0,              // x - alpha
+    BLOB_SCALE_N_CLIP = 1,          // clip(x * beta)
+    BLOB_CLIP = 2,                  // clip(x)
+    BLOB_SCALE_N_BIAS = 3,          // x * beta + gama
+    BLOB_SCALE_N_BIAS_MEAN_SUB = 4, // (x - alpha) * beta + gama
+    BLOB_FUSED_OP = 5               // clip((x - alpha) * beta + gama)
+};
+
+// Fixed point constants of BlobFromImageInt8Graph:
+// q = clamp((x * scale + bias) >> shift, lo, hi)
+struct BlobQuantParams {
+    int scale;
+    int bias;
+    int shift;
+    int lo;
+    int hi;
+};
+
+static constexpr int BLOB_QUANT_MAX_SHIFT = 24;
+
+// Folds op, constants and the int8 output quantization (real = q * out_scale)
+// into one affine map with the most precise shift that keeps scale in int16
+// and bias (with the rounding term) in int32, the clip thresholds become the
+// int8 limits lo / hi. scale and bias are rounded to 2^-shift, so samples
+// within 128 * 2^-shift of a rounding tie may come out one step off
+// (ref/blob_model.cpp checks this bound).
+inline BlobQuantParams blobQuantParams(
+    int op, float alpha, float beta, float gama, int threshold1, int threshold2, float out_scale) {
+    double m = 1.0, c = 0.0;
+    switch (op) {
+        case BLOB_MEAN_SUB:
+            c = -alpha;
+            break;
+        case BLOB_SCALE_N_CLIP:
+            m = beta;
+            break;
+        case BLOB_SCALE_N_BIAS:
+            m = beta;
+            c = gama;
+            break;
+        case BLOB_SCALE_N_BIAS_MEAN_SUB:
+        case BLOB_FUSED_OP:
+            m = beta;
+            c = gama - (double)alpha * beta;
+            break;
+        default: // BLOB_CLIP
+            break;
+    }
+    m /= out_scale;
+    c /= out_scale;
+
+    BlobQuantParams q;
+    q.shift = BLOB_QUANT_MAX_SHIFT;
+    while (q.shift > 0 && (std::fabs(std::ldexp(m, q.shift)) > INT16_MAX ||
+                           std::fabs(std::ldexp(c, q.shift)) + std::ldexp(1.0, q.shift) > INT32_MAX / 2)) {
+        q.shift--;
+    }
+    q.scale = (int)std::lround(std::ldexp(m, q.shift));
+    q.bias = (int)std::lround(std::ldexp(c, q.shift)) + (q.shift ? (1 << (q.shift - 1)) : 0);
+
+    q.lo = INT8_MIN;
+    q.hi = INT8_MAX;
+    if (op == BLOB_SCALE_N_CLIP || op == BLOB_CLIP || op == BLOB_FUSED_OP) {
+        q.lo = std::max(q.lo, (int)std::ceil(threshold1 / out_scale));
+        q.hi = std::min(q.hi, (int)std::floor(threshold2 / out_scale));
+    }
+    return q;
+}
+
+#endif //_BLOB_PARAMS_H_
@@ -3,17 +3,116 @@
 #define _CONFIG_H_
 
 #include <common/xf_aie_const.hpp>
+#include <imgproc/xf_filter_const.hpp>
 
-// tile dimensions are normally computed by tiler but we need to
-// hardcode these values to set the graph window sizes
+// Pixel type, define FILTER2D_8BIT to run the native uint8 filter2D
+// (32 pixels per cycle, tile width must be a multiple of 32, int8 Q7
+// coefficients)
+#ifndef FILTER2D_8BIT
+#define FILTER2D_8BIT 0
+#endif
+#if FILTER2D_8BIT
+using DATA_TYPE = uint8_t;
+using COEFF_TYPE = int8_t;
+static constexpr int FILTER2D_SHIFT = xf::cv::aie::FILTER2D_8B_SRS_SHIFT;
+#else
 using DATA_TYPE = int16_t;
+using COEFF_TYPE = int16_t;
+static constexpr int FILTER2D_SHIFT = xf::cv::aie::FILTER2D_SRS_SHIFT;
+#endif
+
+// tile dimensions are normally computed by tiler but we need to
+// hardcode these values to set the graph window sizes. The kernel reads
+// the actual tile geometry from the metadata, so these are upper bounds:
+// any tile with TILE_WIDTH x TILE_HEIGHT >= width x height fits the window
+// (e.g. 128x32 tiles run in the 64x64 window).
 static constexpr int TILE_WIDTH = 64;
 static constexpr int TILE_HEIGHT = 64;
 static constexpr int TILE_ELEMENTS = (TILE_WIDTH * TILE_HEIGHT);
-static constexpr int TILE_WINDOW_SIZE = ((TILE_ELEMENTS * sizeof(DATA_TYPE)) + xf::cv::aie::METADATA_SIZE);
+// int16 tiles of every graph, Filter2DGraph / Filter2DGmioGraph use
+// FILTER2D_WINDOW_SIZE, which follows DATA_TYPE
+static constexpr int TILE_WINDOW_SIZE = ((TILE_ELEMENTS * sizeof(int16_t)) + xf::cv::aie::METADATA_SIZE);
+static constexpr int FILTER2D_WINDOW_SIZE = ((TILE_ELEMENTS * sizeof(DATA_TYPE)) + xf::cv::aie::METADATA_SIZE);
 //static constexpr int TILE_WINDOW_SIZE = (TILE_ELEMENTS * sizeof(DATA_TYPE));
 
+static constexpr int FILTER_COEFF_SIZE = 16;
+
+// streaming filter2D: full-width row bands, no metadata header
+static constexpr int STREAM_WIDTH = 256;
+static constexpr int STREAM_BAND_HEIGHT = 64;
+static constexpr int STREAM_FRAME_HEIGHT = 256;
+static constexpr int FILTER_STREAM_COEFF_SIZE = 3 * 16;
+
+// Canny: Gaussian, Sobel and non-maximum suppression each consume one pixel
+// of border, the tiler overlap has to cover all three stages
+static constexpr int CANNY_TILE_OVERLAP = 3;
+
+// Harris after filter2D: filter, Sobel and box window each consume one pixel
+static constexpr int HARRIS_TILE_OVERLAP = 3;
+
+// Rectangular morphology structuring element (odd, width at most 17), the
+// tiler overlap is max(W, H) / 2 per erode / dilate stage
+static constexpr int MORPH_KERNEL_W = 9;
+static constexpr int MORPH_KERNEL_H = 9;
+static constexpr int MORPH_TILE_OVERLAP = (MORPH_KERNEL_W > MORPH_KERNEL_H ? MORPH_KERNEL_W : MORPH_KERNEL_H) / 2;
+
+// Integral image: int32 output tiles of the same geometry
+static constexpr int TILE_INTEGRAL_WINDOW_SIZE = ((TILE_ELEMENTS * sizeof(int32_t)) + xf::cv::aie::METADATA_SIZE);
+
+// Box filter: largest runtime radius (the kernel clamps larger ones), the
+// tiler overlap has to cover it
+static constexpr int BOX_MAX_RADIUS = 16;
+static constexpr int BOX_TILE_OVERLAP = BOX_MAX_RADIUS;
+
+// Runtime scale resize of RGBA (4 x uint8) images: the tiler sends the two
+// source rows of one output row, windows fit the widest input / output rows
+static constexpr int RESIZE_MAX_WIDTH_IN = 1920;
+static constexpr int RESIZE_MAX_WIDTH_OUT = 1920;
+static constexpr int RESIZE_CHANNELS = 4;
+static constexpr int RESIZE_IN_WINDOW_SIZE = (2 * RESIZE_MAX_WIDTH_IN * RESIZE_CHANNELS) + xf::cv::aie::METADATA_SIZE;
+static constexpr int RESIZE_OUT_WINDOW_SIZE = (RESIZE_MAX_WIDTH_OUT * RESIZE_CHANNELS) + xf::cv::aie::METADATA_SIZE;
+
+// Area downscale: ceil(scale_y) + 1 source rows per output row, inputs of up
+// to RESIZE_AREA_MAX_WIDTH_IN pixels (resizeAreaRows rejects larger ones)
+static constexpr int RESIZE_AREA_MAX_WIDTH_IN = 512;
+static constexpr int RESIZE_AREA_MAX_ROWS_IN = 9; // scale_y up to 8
+static constexpr int RESIZE_AREA_IN_WINDOW_SIZE =
+    (RESIZE_AREA_MAX_ROWS_IN * RESIZE_AREA_MAX_WIDTH_IN * RESIZE_CHANNELS) + xf::cv::aie::METADATA_SIZE;
+
+// Bicubic (upscaling): four source rows per output row, inputs of up to
+// RESIZE_CUBIC_MAX_WIDTH_IN pixels (resizeCubicRows rejects larger ones)
+static constexpr int RESIZE_CUBIC_MAX_WIDTH_IN = 960;
+static constexpr int RESIZE_CUBIC_IN_WINDOW_SIZE =
+    (4 * RESIZE_CUBIC_MAX_WIDTH_IN * RESIZE_CHANNELS) + xf::cv::aie::METADATA_SIZE;
+
+// Letterbox resize: planar int8 rows of the network input width (at most
+// RESIZE_MAX_WIDTH_OUT), the geometry and the normalization are runtime
+// parameters (int16_t[16])
+static constexpr int LETTERBOX_OUT_WINDOW_SIZE = RESIZE_MAX_WIDTH_OUT + xf::cv::aie::METADATA_SIZE;
+enum LetterboxParam {
+    LETTERBOX_PAD_LEFT = 0,   // multiple of 16
+    LETTERBOX_CONTENT_W = 1,  // multiple of 16
+    LETTERBOX_PAD_VALUE = 2,  // uint8 pixel value of the pad bands
+    LETTERBOX_MEAN = 3,       // 3 entries, R G B
+    LETTERBOX_ALPHA = 6,      // 3 entries, gain with 4 fractional bits
+    LETTERBOX_NET_W = 9,      // network input width, multiple of 16
+    LETTERBOX_PARAMS = 16
+};
+
+// blobFromImage: float tiles, or uint8 -> int8 for the quantized output
+static constexpr int TILE_FLOAT_WINDOW_SIZE = ((TILE_ELEMENTS * sizeof(float)) + xf::cv::aie::METADATA_SIZE);
+static constexpr int TILE_INT8_WINDOW_SIZE = ((TILE_ELEMENTS * sizeof(int8_t)) + xf::cv::aie::METADATA_SIZE);
+
 /* Graph specific configuration */
-//static constexpr int VECTORIZATION_FACTOR = 16;
+// Number of filter kernels, must match the data movers CORES parameter
+static constexpr int NUM_CORES = 1;
+static constexpr int VECTORIZATION_FACTOR = FILTER2D_8BIT ? 32 : 16;
+
+// Select the GMIO graph / data movers instead of PLIO + PL data movers
+#ifndef FILTER2D_USE_GMIO
+#define FILTER2D_USE_GMIO 0
+#endif
+static constexpr int GMIO_BURST_LENGTH = 256; // bytes
+static constexpr int GMIO_BANDWIDTH = 1000;   // MB/s
 
 #endif //__CONFIG_H_
\ No newline at end of file
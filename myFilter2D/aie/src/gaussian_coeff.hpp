@@ -0,0 +1,138 @@
+#ifndef _GAUSSIAN_COEFF_H_
+#define _GAUSSIAN_COEFF_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include "config.hpp"
+
+// Fixed point Gaussian coefficients for the runtime parameters of the
+// GAUSSIAN_3x3 / GAUSSIAN_5x5 graph modes, computed on the host from sigma
+// (e.g. following the scene gain) and pushed with graph.update() between
+// frames. Taps are rounded to GAUSSIAN_COEFF_BITS fractional bits and the
+// centre tap absorbs the rounding error, so every kernel sums to exactly one
+// and flat areas keep their level.
+static constexpr int GAUSSIAN_COEFF_BITS = 14;
+
+// sigma <= 0 (or NaN) would divide by zero in the weights below
+inline void gaussianCheckSigma(float sigma) {
+    if (!(sigma > 0.0f)) throw std::runtime_error("Gaussian sigma must be positive");
+}
+
+// 1D taps g[0] (centre) .. g[R], sum of g[-R..R] == 1 << GAUSSIAN_COEFF_BITS
+template <int R>
+inline void gaussianTaps(float sigma, int16_t (&g)[R + 1]) {
+    gaussianCheckSigma(sigma);
+    double w[R + 1];
+    double sum = 0.0;
+    for (int k = 0; k <= R; k++) {
+        w[k] = std::exp(-(double)(k * k) / (2.0 * sigma * sigma));
+        sum += (k == 0) ? w[k] : 2.0 * w[k];
+    }
+    int fixed_sum = 0;
+    for (int k = R; k >= 0; k--) {
+        g[k] = (int16_t)std::lround(w[k] / sum * (1 << GAUSSIAN_COEFF_BITS));
+        fixed_sum += (k == 0) ? g[k] : 2 * g[k];
+    }
+    g[0] += (int16_t)((1 << GAUSSIAN_COEFF_BITS) - fixed_sum);
+}
+
+// 3x3: full 2D kernel in the filter2D_k3_border layout
+// (k0 k1 0 k2 0 k3 k4 0 k5 0 k6 k7 0 k8 0 0), rounded to 'bits' fractional bits
+inline void gaussianCoeffK3(float sigma,
+                            int16_t (&coeff)[FILTER_COEFF_SIZE],
+                            int& shift,
+                            int bits = GAUSSIAN_COEFF_BITS) {
+    gaussianCheckSigma(sigma);
+    double w[3];
+    for (int k = 0; k < 3; k++) w[k] = std::exp(-(double)((k - 1) * (k - 1)) / (2.0 * sigma * sigma));
+    double sum = 0.0;
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 3; c++) sum += w[r] * w[c];
+
+    int16_t k[9];
+    int fixed_sum = 0;
+    for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 3; c++) {
+            k[3 * r + c] = (int16_t)std::lround(w[r] * w[c] / sum * (1 << bits));
+            fixed_sum += k[3 * r + c];
+        }
+    k[4] += (int16_t)((1 << bits) - fixed_sum);
+
+    const int16_t layout[FILTER_COEFF_SIZE] = {k[0], k[1], 0, k[2], 0, k[3], k[4], 0,
+                                               k[5], 0,    k[6], k[7], 0, k[8], 0, 0};
+    for (int n = 0; n < FILTER_COEFF_SIZE; n++) coeff[n] = layout[n];
+    shift = bits;
+}
+
+// 5x5: unique 1D taps {g0, g1, g2}, applied vertically then horizontally,
+// the kernel splits 'shift' between the two passes
+inline void gaussianCoeffK5(float sigma, int16_t (&coeff)[FILTER_COEFF_SIZE], int& shift) {
+    int16_t g[3];
+    gaussianTaps<2>(sigma, g);
+    for (int n = 0; n < FILTER_COEFF_SIZE; n++) coeff[n] = (n < 3) ? g[n] : 0;
+    shift = 2 * GAUSSIAN_COEFF_BITS;
+}
+
+// Unsharp mask: 3x3 Gaussian blur in the filter2D layout plus the amount in
+// coeff[15], with UNSHARP_AMOUNT_BITS (xf_filter_const.hpp) fractional bits
+inline void unsharpCoeffK3(float sigma, float amount, int16_t (&coeff)[FILTER_COEFF_SIZE], int& shift) {
+    gaussianCoeffK3(sigma, coeff, shift);
+    coeff[15] = (int16_t)std::lround(amount * (1 << xf::cv::aie::UNSHARP_AMOUNT_BITS));
+}
+
+// Bilateral: 3x3 Gaussian spatial weights summing to 1 << BILATERAL_WEIGHT_BITS
+// (xf_filter_const.hpp). The kernel range sigma is 16 << shift intensity
+// levels, so range_sigma is rounded to the nearest power of two multiple of
+// 16 and returned in 'shift'.
+inline void bilateralCoeffK3(float sigma, float range_sigma, int16_t (&coeff)[FILTER_COEFF_SIZE], int& shift) {
+    gaussianCoeffK3(sigma, coeff, shift, xf::cv::aie::BILATERAL_WEIGHT_BITS);
+    if (coeff[6] < xf::cv::aie::BILATERAL_MIN_CENTRE_WEIGHT)
+        throw std::runtime_error("Bilateral centre weight below BILATERAL_MIN_CENTRE_WEIGHT");
+    shift = std::max(0, (int)std::lround(std::log2(range_sigma / 16.0f)));
+}
+
+// Laplacian of Gaussian 5x5: the 9 unique values L(dy, dx) of the kernel
+// (symmetric about both axes) in coeff[3 * dy + dx]. The window truncates
+// the kernel, its mean is subtracted from every tap (the centre absorbs the
+// rounding error) so flat areas give no response. Taps use the most
+// fractional bits, at most LOG_COEFF_BITS, that keep them int16 with
+// headroom, returned in 'shift'.
+static constexpr int LOG_COEFF_BITS = 14;
+
+inline void logCoeffK5(float sigma, int16_t (&coeff)[FILTER_COEFF_SIZE], int& shift) {
+    gaussianCheckSigma(sigma);
+    // Taps appear once (centre), twice (on an axis) or four times in the 5x5 kernel
+    auto count = [](int dy, int dx) { return (dy == 0 && dx == 0) ? 1 : (dy == 0 || dx == 0) ? 2 : 4; };
+
+    const double s2 = (double)sigma * sigma;
+    double l[9];
+    double mean = 0.0;
+    for (int dy = 0; dy < 3; dy++)
+        for (int dx = 0; dx < 3; dx++) {
+            const double r2 = dx * dx + dy * dy;
+            l[3 * dy + dx] = -(1.0 - r2 / (2.0 * s2)) * std::exp(-r2 / (2.0 * s2)) / (std::acos(-1.0) * s2 * s2);
+            mean += l[3 * dy + dx] * count(dy, dx) / 25.0;
+        }
+
+    double peak = 0.0;
+    for (int n = 0; n < 9; n++) {
+        l[n] -= mean;
+        peak = std::max(peak, std::fabs(l[n]));
+    }
+    int bits = LOG_COEFF_BITS;
+    while (bits > 0 && peak * 2.0 * (1 << bits) > 32767.0) bits--;
+
+    int fixed_sum = 0;
+    for (int n = 0; n < FILTER_COEFF_SIZE; n++) coeff[n] = 0;
+    for (int dy = 0; dy < 3; dy++)
+        for (int dx = 0; dx < 3; dx++) {
+            coeff[3 * dy + dx] = (int16_t)std::lround(l[3 * dy + dx] * (1 << bits));
+            fixed_sum += coeff[3 * dy + dx] * count(dy, dx);
+        }
+    coeff[0] -= (int16_t)fixed_sum;
+    shift = bits;
+}
+
+#endif //_GAUSSIAN_COEFF_H_
@@ -1,17 +1,67 @@
 
 #include "graph.h"
+#if FILTER2D_USE_GMIO
+#include <cstring>
+#include <common/xf_aie_utils.hpp>
+#endif
 
 using namespace adf;
 
 // Graph object
-Filter2DGraph filter_graph;
+#if FILTER2D_USE_GMIO
+Filter2DGmioGraph<> filter_graph;
+#else
+Filter2DGraph<> filter_graph;
+#endif
 // simulation::platform<1,1> platform("data/input.txt", "data/output.txt");
 // connect<> net0(platform.src[0], filter_graph.in);
 // connect<> net1(filter_graph.out, platform.sink[0]);
 
+/*
+Floating point values of the kernel
+kData[9] = {0.0625, 0.125, 0.0625, 0.125, 0.25, 0.125, 0.0625, 0.125, 0.0625};
+*/
+#if FILTER2D_8BIT
+const COEFF_TYPE coeff[FILTER_COEFF_SIZE] = {8, 16, 0, 8, 0, 16, 32, 0, 16, 0, 8, 16, 0, 8, 0, 0};
+#else
+const COEFF_TYPE coeff[FILTER_COEFF_SIZE] = {64, 128, 0, 64, 0, 128, 256, 0, 128, 0, 64, 128, 0, 64, 0, 0};
+#endif
+const int shift = FILTER2D_SHIFT;
+
+#if defined(__AIESIM__) || defined(__X86SIM__)
 int main(void) {
   filter_graph.init();
+  for (int i = 0; i < NUM_CORES; i++) {
+    filter_graph.update(filter_graph.coeff[i], coeff, FILTER_COEFF_SIZE);
+    filter_graph.update(filter_graph.shift[i], shift);
+  }
+#if FILTER2D_USE_GMIO
+  // One full size tile per core, ramp image data
+  DATA_TYPE* in[NUM_CORES];
+  DATA_TYPE* out[NUM_CORES];
+  for (int i = 0; i < NUM_CORES; i++) {
+    in[i] = (DATA_TYPE*)GMIO::malloc(FILTER2D_WINDOW_SIZE);
+    out[i] = (DATA_TYPE*)GMIO::malloc(FILTER2D_WINDOW_SIZE);
+    memset(in[i], 0, xf::cv::aie::METADATA_SIZE);
+    xf::cv::aie::xfSetTileWidth(in[i], TILE_WIDTH);
+    xf::cv::aie::xfSetTileHeight(in[i], TILE_HEIGHT);
+    DATA_TYPE* data = (DATA_TYPE*)xf::cv::aie::xfGetImgDataPtr(in[i]);
+    for (int j = 0; j < TILE_ELEMENTS; j++) data[j] = (DATA_TYPE)(j & 0xff);
+    filter_graph.in[i].gm2aie_nb(in[i], FILTER2D_WINDOW_SIZE);
+  }
+  filter_graph.run(1);
+  for (int i = 0; i < NUM_CORES; i++) {
+    filter_graph.out[i].aie2gm(out[i], FILTER2D_WINDOW_SIZE);
+  }
+  filter_graph.end();
+  for (int i = 0; i < NUM_CORES; i++) {
+    GMIO::free(in[i]);
+    GMIO::free(out[i]);
+  }
+#else
   filter_graph.run(1);
   filter_graph.end();
+#endif
   return 0;
 }
+#endif
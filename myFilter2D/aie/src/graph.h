@@ -1,33 +1,644 @@
-
 #ifndef __GRAPH_H__
 #define __GRAPH_H__
 
 #include <adf.h>
+#include <stdexcept>
+#include <string>
 #include "aie_kernels.h"
 #include "config.hpp"
 
 using namespace adf;
 
+// PLIO port names are numbered from 1 (DataIn1, DataOut1, ...), the
+// simulation files of single core designs keep their original names
+inline std::string plio_name(const std::string& prefix, int i) {
+    return prefix + std::to_string(i + 1);
+}
+
+template <int CORES>
+inline std::string data_file(const std::string& prefix, int i) {
+    return (CORES == 1) ? (prefix + ".txt") : (prefix + std::to_string(i) + ".txt");
+}
+
+// Kernel selection, all modes share the same ports:
+// GENERIC   : any 3x3 kernel
+// SEPARABLE : rank-1 kernel, coefficients passed as horizontal / vertical
+//             taps (see filter2D_separable)
+// SEPARABLE_5x5 / SEPARABLE_7x7 : rank-1 5x5 / 7x7 kernels, same layout,
+//             tiler overlap of 2 / 3
+// SYMMETRIC : kernel symmetric about both axes, filter2D layout
+// GAUSSIAN_3x3 / GAUSSIAN_5x5 : runtime sigma Gaussian, coefficients and
+//             shift from gaussianCoeffK3 / gaussianCoeffK5 (gaussian_coeff.hpp),
+//             the 5x5 needs a tiler overlap of 2
+// UNSHARP   : Gaussian blur + addweighted sharpening fused in one kernel,
+//             coefficients from unsharpCoeffK3 (gaussian_coeff.hpp)
+// SOBEL_DX / SOBEL_DY / SOBEL_L1 : 3x3 gradients dx, dy or |dx| + |dy|,
+//             coeff[0..1] = smoothing taps ({1, 2} Sobel, {3, 10} Scharr)
+// BILATERAL : 3x3 edge-preserving smoothing, spatial weights and range
+//             scale from bilateralCoeffK3 (gaussian_coeff.hpp)
+// LOG_5x5   : fused Laplacian of Gaussian, signed output, coefficients and
+//             shift from logCoeffK5 (gaussian_coeff.hpp), tiler overlap of 2
+// With FILTER2D_8BIT, Filter2DGraph and Filter2DGmioGraph only accept GENERIC
+// (uint8 windows, int8 Q7 coefficients), HarrisGraph keeps the int16 kernels.
+enum class Filter2DMode {
+    GENERIC,
+    SEPARABLE,
+    SEPARABLE_5x5,
+    SEPARABLE_7x7,
+    SYMMETRIC,
+    GAUSSIAN_3x3,
+    GAUSSIAN_5x5,
+    UNSHARP,
+    SOBEL_DX,
+    SOBEL_DY,
+    SOBEL_L1,
+    BILATERAL,
+    LOG_5x5
+};
+
+inline kernel createFilter2DInt16Kernel(Filter2DMode mode) {
+    switch (mode) {
+        case Filter2DMode::SEPARABLE:
+            return kernel::create(filter2D_separable);
+        case Filter2DMode::SEPARABLE_5x5:
+            return kernel::create(filter2D_separable_k5);
+        case Filter2DMode::SEPARABLE_7x7:
+            return kernel::create(filter2D_separable_k7);
+        case Filter2DMode::SYMMETRIC:
+            return kernel::create(filter2D_symmetric);
+        case Filter2DMode::GAUSSIAN_3x3:
+            return kernel::create(gaussian);
+        case Filter2DMode::GAUSSIAN_5x5:
+            return kernel::create(gaussian_k5);
+        case Filter2DMode::UNSHARP:
+            return kernel::create(unsharp);
+        case Filter2DMode::SOBEL_DX:
+            return kernel::create(sobel_dx);
+        case Filter2DMode::SOBEL_DY:
+            return kernel::create(sobel_dy);
+        case Filter2DMode::SOBEL_L1:
+            return kernel::create(sobel_l1);
+        case Filter2DMode::BILATERAL:
+            return kernel::create(bilateral);
+        case Filter2DMode::LOG_5x5:
+            return kernel::create(laplacian_of_gaussian);
+        default:
+            return kernel::create(filter2D);
+    }
+}
+
+// Kernel on DATA_TYPE tiles (FILTER2D_WINDOW_SIZE)
+inline kernel createFilter2DKernel(Filter2DMode mode) {
+#if FILTER2D_8BIT
+    if (mode != Filter2DMode::GENERIC) {
+        throw std::runtime_error("FILTER2D_8BIT only supports Filter2DMode::GENERIC");
+    }
+    return kernel::create(filter2D_8b);
+#else
+    return createFilter2DInt16Kernel(mode);
+#endif
+}
+
+// CORES must match the CORES parameter of the xfcvDataMovers tiler/stitcher
+// on the host: core i consumes the tiles sent by Tiler_top_<i+1> and feeds
+// stitcher_top_<i+1>.
+template <int CORES = NUM_CORES>
 class Filter2DGraph : public adf::graph {
+    public:
+        kernel f2d[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port coeff[CORES];
+        input_port shift[CORES];
+        // input_port in;
+        // output_port out;
+
+        Filter2DGraph(Filter2DMode mode = Filter2DMode::GENERIC) {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                f2d[i] = createFilter2DKernel(mode);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] =
+                    output_plio::create(plio_name("DataOut", i), plio_128_bits, data_file<CORES>("data/output", i));
+
+                //Make AIE connections
+                adf::connect<window<FILTER2D_WINDOW_SIZE> >(in[i].out[0], f2d[i].in[0]);
+                adf::connect<window<FILTER2D_WINDOW_SIZE> >(f2d[i].out[0], out[i].in[0]);
+                // connect< window<TILE_WINDOW_SIZE> > net0 (in, f2d.in[0]);
+                // connect< window<TILE_WINDOW_SIZE> > net1 (f2d.out[0], out);
+
+                // Runtime parameters, async so filters can be swapped between
+                // frames without stalling the graph
+                adf::connect<parameter>(coeff[i], async(f2d[i].in[1]));
+                adf::connect<parameter>(shift[i], async(f2d[i].in[2]));
+
+                source(f2d[i]) = "aie_kernels/aie_filter2D.cpp";
+                runtime<ratio>(f2d[i]) = 0.99;
+            }
+    };
+};
+
+// GMIO variant: tiles are read from / written to DDR by the AIE shim DMA,
+// driven by the GMIO tiler/stitcher (xfcvDataMovers<..., CORES, 0, true>)
+// with port names "gmioIn[i]" / "gmioOut[i]". No PL data movers are needed.
+template <int CORES = NUM_CORES>
+class Filter2DGmioGraph : public adf::graph {
+    public:
+        kernel f2d[CORES];
+        input_gmio in[CORES];
+        output_gmio out[CORES];
+        input_port coeff[CORES];
+        input_port shift[CORES];
+
+        // burst_length: shim DMA burst in bytes (64, 128 or 256)
+        // bandwidth: required DDR bandwidth in MB/s, used by the compiler
+        //            to allocate NoC bandwidth
+        Filter2DGmioGraph(Filter2DMode mode = Filter2DMode::GENERIC,
+                          int burst_length = GMIO_BURST_LENGTH,
+                          int bandwidth = GMIO_BANDWIDTH) {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                f2d[i] = createFilter2DKernel(mode);
+
+                in[i] = input_gmio::create(port_name("gmioIn", i), burst_length, bandwidth);
+                out[i] = output_gmio::create(port_name("gmioOut", i), burst_length, bandwidth);
+
+                //Make AIE connections
+                adf::connect<window<FILTER2D_WINDOW_SIZE> >(in[i].out[0], f2d[i].in[0]);
+                adf::connect<window<FILTER2D_WINDOW_SIZE> >(f2d[i].out[0], out[i].in[0]);
+
+                adf::connect<parameter>(coeff[i], async(f2d[i].in[1]));
+                adf::connect<parameter>(shift[i], async(f2d[i].in[2]));
+
+                source(f2d[i]) = "aie_kernels/aie_filter2D.cpp";
+                runtime<ratio>(f2d[i]) = 0.99;
+            }
+    };
+
+    private:
+        static std::string port_name(const std::string& prefix, int i) {
+            return prefix + "[" + std::to_string(i) + "]";
+        }
+};
+
+// Canny edge detection, one AIE tile per stage:
+// gaussian -> canny_gradient (Sobel, packed magnitude / direction)
+//          -> canny_nms (non-maximum suppression) -> canny_threshold
+// The host tiler must use an overlap of CANNY_TILE_OVERLAP, metadata travels
+// with every tile so the stitcher sees the usual layout. The output marks
+// strong edges with 255 and weak edges with 128, hysteresis (keeping weak
+// pixels connected to strong ones) runs on the stitched image.
+template <int CORES = NUM_CORES>
+class CannyGraph : public adf::graph {
+    public:
+        kernel gauss[CORES];
+        kernel grad[CORES];
+        kernel nms[CORES];
+        kernel thresh[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port coeff[CORES];
+        input_port shift[CORES];
+        input_port low[CORES];
+        input_port high[CORES];
+
+        CannyGraph() {
+            for (int i = 0; i < CORES; i++) {
+                // create kernels
+                gauss[i] = kernel::create(gaussian);
+                grad[i] = kernel::create(canny_gradient);
+                nms[i] = kernel::create(canny_nms);
+                thresh[i] = kernel::create(canny_threshold);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/canny_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_WINDOW_SIZE> >(in[i].out[0], gauss[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(gauss[i].out[0], grad[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(grad[i].out[0], nms[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(nms[i].out[0], thresh[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(thresh[i].out[0], out[i].in[0]);
+
+                // Gaussian coefficients (gaussianCoeffK3) and thresholds
+                adf::connect<parameter>(coeff[i], async(gauss[i].in[1]));
+                adf::connect<parameter>(shift[i], async(gauss[i].in[2]));
+                adf::connect<parameter>(low[i], async(thresh[i].in[1]));
+                adf::connect<parameter>(high[i], async(thresh[i].in[2]));
+
+                source(gauss[i]) = "aie_kernels/aie_filter2D.cpp";
+                source(grad[i]) = "aie_kernels/aie_canny.cpp";
+                source(nms[i]) = "aie_kernels/aie_canny.cpp";
+                source(thresh[i]) = "aie_kernels/aie_canny.cpp";
+                runtime<ratio>(gauss[i]) = 0.99;
+                runtime<ratio>(grad[i]) = 0.99;
+                runtime<ratio>(nms[i]) = 0.99;
+                runtime<ratio>(thresh[i]) = 0.99;
+            }
+    };
+};
+
+// Harris corner response as a stage after filter2D (e.g. a Gaussian to
+// denoise before differentiating). The host tiler must use an overlap of
+// HARRIS_TILE_OVERLAP, the output tile holds the fixed point response.
+template <int CORES = NUM_CORES>
+class HarrisGraph : public adf::graph {
+    public:
+        kernel f2d[CORES];
+        kernel corner[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port coeff[CORES];
+        input_port shift[CORES];
+        input_port k[CORES];
+        input_port response_shift[CORES];
+
+        HarrisGraph(Filter2DMode mode = Filter2DMode::GENERIC) {
+            for (int i = 0; i < CORES; i++) {
+                // create kernels
+                f2d[i] = createFilter2DInt16Kernel(mode);
+                corner[i] = kernel::create(harris);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/harris_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_WINDOW_SIZE> >(in[i].out[0], f2d[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(f2d[i].out[0], corner[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(corner[i].out[0], out[i].in[0]);
+
+                adf::connect<parameter>(coeff[i], async(f2d[i].in[1]));
+                adf::connect<parameter>(shift[i], async(f2d[i].in[2]));
+                adf::connect<parameter>(k[i], async(corner[i].in[1]));
+                adf::connect<parameter>(response_shift[i], async(corner[i].in[2]));
+
+                source(f2d[i]) = "aie_kernels/aie_filter2D.cpp";
+                source(corner[i]) = "aie_kernels/aie_harris.cpp";
+                runtime<ratio>(f2d[i]) = 0.99;
+                runtime<ratio>(corner[i]) = 0.99;
+            }
+    };
+};
+
+// Rectangular morphology, MORPH_KERNEL_W x MORPH_KERNEL_H element.
+// OPEN (erode, dilate) and CLOSE (dilate, erode) chain two kernels and need
+// a tiler overlap of 2 * MORPH_TILE_OVERLAP, ERODE / DILATE one of
+// MORPH_TILE_OVERLAP.
+enum class MorphMode { ERODE, DILATE, OPEN, CLOSE };
+
+template <int CORES = NUM_CORES>
+class MorphologyGraph : public adf::graph {
+    public:
+        kernel morph[CORES][2];
+        input_plio in[CORES];
+        output_plio out[CORES];
+
+        MorphologyGraph(MorphMode mode = MorphMode::OPEN) {
+            const int stages = (mode == MorphMode::OPEN || mode == MorphMode::CLOSE) ? 2 : 1;
+            for (int i = 0; i < CORES; i++) {
+                // create kernels
+                switch (mode) {
+                    case MorphMode::ERODE:
+                        morph[i][0] = kernel::create(erode_rect);
+                        break;
+                    case MorphMode::DILATE:
+                        morph[i][0] = kernel::create(dilate_rect);
+                        break;
+                    case MorphMode::OPEN:
+                        morph[i][0] = kernel::create(erode_rect);
+                        morph[i][1] = kernel::create(dilate_rect);
+                        break;
+                    case MorphMode::CLOSE:
+                        morph[i][0] = kernel::create(dilate_rect);
+                        morph[i][1] = kernel::create(erode_rect);
+                        break;
+                }
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/morph_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_WINDOW_SIZE> >(in[i].out[0], morph[i][0].in[0]);
+                if (stages == 2) adf::connect<window<TILE_WINDOW_SIZE> >(morph[i][0].out[0], morph[i][1].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(morph[i][stages - 1].out[0], out[i].in[0]);
+
+                for (int s = 0; s < stages; s++) {
+                    source(morph[i][s]) = "aie_kernels/aie_morphology.cpp";
+                    runtime<ratio>(morph[i][s]) = 0.99;
+                }
+            }
+    };
+};
+
+// Median filter (salt-and-pepper removal), ksize 3 or 5, the host tiler
+// needs an overlap of ksize / 2
+template <int CORES = NUM_CORES>
+class MedianGraph : public adf::graph {
+    public:
+        kernel median[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+
+        MedianGraph(int ksize = 3) {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                median[i] = (ksize == 5) ? kernel::create(median5x5) : kernel::create(median3x3);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/median_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_WINDOW_SIZE> >(in[i].out[0], median[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(median[i].out[0], out[i].in[0]);
+
+                source(median[i]) = "aie_kernels/aie_median.cpp";
+                runtime<ratio>(median[i]) = 0.99;
+            }
+    };
+};
+
+// Integral image: int32 summed-area table per tile, the host tiler runs
+// without overlap and the stitcher with int32 pixels, integralCombineTiles
+// (integral_image.hpp) turns the stitched tables into the image integral
+template <int CORES = NUM_CORES>
+class IntegralGraph : public adf::graph {
+    public:
+        kernel sat[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+
+        IntegralGraph() {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                sat[i] = kernel::create(integral);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/integral_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_WINDOW_SIZE> >(in[i].out[0], sat[i].in[0]);
+                adf::connect<window<TILE_INTEGRAL_WINDOW_SIZE> >(sat[i].out[0], out[i].in[0]);
+
+                source(sat[i]) = "aie_kernels/aie_integral.cpp";
+                runtime<ratio>(sat[i]) = 0.99;
+            }
+    };
+};
+
+// Box (mean) filter on the tile summed-area table, constant cost for any
+// radius up to BOX_MAX_RADIUS (larger ones are clamped), the host tiler
+// needs BOX_TILE_OVERLAP
+template <int CORES = NUM_CORES>
+class BoxFilterGraph : public adf::graph {
+    public:
+        kernel box[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port radius[CORES];
+
+        BoxFilterGraph() {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                box[i] = kernel::create(box_filter);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] =
+                    output_plio::create(plio_name("DataOut", i), plio_128_bits, data_file<CORES>("data/box_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_WINDOW_SIZE> >(in[i].out[0], box[i].in[0]);
+                adf::connect<window<TILE_WINDOW_SIZE> >(box[i].out[0], out[i].in[0]);
+
+                adf::connect<parameter>(radius[i], async(box[i].in[1]));
+
+                source(box[i]) = "aie_kernels/aie_integral.cpp";
+                runtime<ratio>(box[i]) = 0.99;
+            }
+    };
+};
+
+// Resize of RGBA images with runtime scale factors: the host tiler runs in
+// resize mode (output size != input size), which sends the source rows of
+// each output row, and scale_x / scale_y come from resizeScaleQ16
+// (resize_params.hpp), so one graph serves every output resolution.
+// BILINEAR : two source rows per output row (default tiler)
+// AREA     : INTER_AREA downscale (scale >= 1), ceil(scale_y) + 1 source
+//            rows per output row, the tiler needs mResizeRows =
+//            resizeAreaRows(), inputs of up to RESIZE_AREA_MAX_WIDTH_IN
+// BICUBIC  : 4x4 taps, four source rows per output row, the tiler needs
+//            mResizeRows = resizeCubicRows(), inputs of up to
+//            RESIZE_CUBIC_MAX_WIDTH_IN
+enum class ResizeMode {
+    BILINEAR,
+    AREA,
+    BICUBIC
+};
+
+template <int CORES = NUM_CORES>
+class ResizeGraph : public adf::graph {
+    public:
+        kernel resize[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port scale_x[CORES];
+        input_port scale_y[CORES];
+
+        ResizeGraph(ResizeMode mode = ResizeMode::BILINEAR) {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                switch (mode) {
+                    case ResizeMode::AREA:
+                        resize[i] = kernel::create(resize_area);
+                        break;
+                    case ResizeMode::BICUBIC:
+                        resize[i] = kernel::create(resize_bicubic);
+                        break;
+                    default:
+                        resize[i] = kernel::create(resize_bilinear);
+                        break;
+                }
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/resize_output", i));
+
+                //Make AIE connections
+                if (mode == ResizeMode::AREA) {
+                    adf::connect<window<RESIZE_AREA_IN_WINDOW_SIZE> >(in[i].out[0], resize[i].in[0]);
+                } else if (mode == ResizeMode::BICUBIC) {
+                    adf::connect<window<RESIZE_CUBIC_IN_WINDOW_SIZE> >(in[i].out[0], resize[i].in[0]);
+                } else {
+                    adf::connect<window<RESIZE_IN_WINDOW_SIZE> >(in[i].out[0], resize[i].in[0]);
+                }
+                adf::connect<window<RESIZE_OUT_WINDOW_SIZE> >(resize[i].out[0], out[i].in[0]);
+
+                adf::connect<parameter>(scale_x[i], async(resize[i].in[1]));
+                adf::connect<parameter>(scale_y[i], async(resize[i].in[2]));
+
+                source(resize[i]) = "aie_kernels/aie_resize.cpp";
+                runtime<ratio>(resize[i]) = 0.99;
+            }
+    };
+};
+
+// Letterbox resize + normalization into planar R, G and B int8 outputs.
+// The tiler runs with the content size content_w x content_h, the kernel
+// writes net_w (LETTERBOX_NET_W) wide rows with the side bands and sets that
+// output width in the metadata. The stitchers write the planes at row
+// pad_top; the constant bands above and below only change with the geometry.
+template <int CORES = NUM_CORES>
+class LetterboxGraph : public adf::graph {
+    public:
+        kernel resize[CORES];
+        input_plio in[CORES];
+        output_plio out_r[CORES];
+        output_plio out_g[CORES];
+        output_plio out_b[CORES];
+        input_port scale_x[CORES];
+        input_port scale_y[CORES];
+        input_port params[CORES];
+
+        LetterboxGraph() {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                resize[i] = kernel::create(resize_letterbox);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out_r[i] = output_plio::create(plio_name("DataOutR", i), plio_128_bits,
+                                               data_file<CORES>("data/letterbox_r", i));
+                out_g[i] = output_plio::create(plio_name("DataOutG", i), plio_128_bits,
+                                               data_file<CORES>("data/letterbox_g", i));
+                out_b[i] = output_plio::create(plio_name("DataOutB", i), plio_128_bits,
+                                               data_file<CORES>("data/letterbox_b", i));
+
+                //Make AIE connections
+                adf::connect<window<RESIZE_IN_WINDOW_SIZE> >(in[i].out[0], resize[i].in[0]);
+                adf::connect<window<LETTERBOX_OUT_WINDOW_SIZE> >(resize[i].out[0], out_r[i].in[0]);
+                adf::connect<window<LETTERBOX_OUT_WINDOW_SIZE> >(resize[i].out[1], out_g[i].in[0]);
+                adf::connect<window<LETTERBOX_OUT_WINDOW_SIZE> >(resize[i].out[2], out_b[i].in[0]);
+
+                adf::connect<parameter>(scale_x[i], async(resize[i].in[1]));
+                adf::connect<parameter>(scale_y[i], async(resize[i].in[2]));
+                adf::connect<parameter>(params[i], async(resize[i].in[3]));
+
+                source(resize[i]) = "aie_kernels/aie_resize.cpp";
+                runtime<ratio>(resize[i]) = 0.99;
+            }
+    };
+};
+
+// blobFromImage (DNN input normalization) on float tiles, the op (enum ops
+// in xf_blobfromimage_aie.hpp) and its constants are runtime parameters.
+template <int CORES = NUM_CORES>
+class BlobFromImageGraph : public adf::graph {
+    public:
+        kernel blob[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port op[CORES];
+        input_port alpha[CORES];
+        input_port beta[CORES];
+        input_port gama[CORES];
+        input_port threshold1[CORES];
+        input_port threshold2[CORES];
+
+        BlobFromImageGraph() {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                blob[i] = kernel::create(blob_from_image);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/blob_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_FLOAT_WINDOW_SIZE> >(in[i].out[0], blob[i].in[0]);
+                adf::connect<window<TILE_FLOAT_WINDOW_SIZE> >(blob[i].out[0], out[i].in[0]);
+
+                adf::connect<parameter>(op[i], async(blob[i].in[1]));
+                adf::connect<parameter>(alpha[i], async(blob[i].in[2]));
+                adf::connect<parameter>(beta[i], async(blob[i].in[3]));
+                adf::connect<parameter>(gama[i], async(blob[i].in[4]));
+                adf::connect<parameter>(threshold1[i], async(blob[i].in[5]));
+                adf::connect<parameter>(threshold2[i], async(blob[i].in[6]));
+
+                source(blob[i]) = "aie_kernels/aie_blobfromimage.cpp";
+                runtime<ratio>(blob[i]) = 0.99;
+            }
+    };
+};
+
+// Quantized blobFromImage: uint8 tiles in, int8 tiles out, the fixed point
+// constants come from blobQuantParams (blob_params.hpp).
+template <int CORES = NUM_CORES>
+class BlobFromImageInt8Graph : public adf::graph {
+    public:
+        kernel blob[CORES];
+        input_plio in[CORES];
+        output_plio out[CORES];
+        input_port scale[CORES];
+        input_port bias[CORES];
+        input_port shift[CORES];
+        input_port lo[CORES];
+        input_port hi[CORES];
+
+        BlobFromImageInt8Graph() {
+            for (int i = 0; i < CORES; i++) {
+                // create kernel
+                blob[i] = kernel::create(blob_from_image_int8);
+
+                in[i] = input_plio::create(plio_name("DataIn", i), plio_128_bits, data_file<CORES>("data/input", i));
+                out[i] = output_plio::create(plio_name("DataOut", i), plio_128_bits,
+                                             data_file<CORES>("data/blob_output", i));
+
+                //Make AIE connections
+                adf::connect<window<TILE_INT8_WINDOW_SIZE> >(in[i].out[0], blob[i].in[0]);
+                adf::connect<window<TILE_INT8_WINDOW_SIZE> >(blob[i].out[0], out[i].in[0]);
+
+                adf::connect<parameter>(scale[i], async(blob[i].in[1]));
+                adf::connect<parameter>(bias[i], async(blob[i].in[2]));
+                adf::connect<parameter>(shift[i], async(blob[i].in[3]));
+                adf::connect<parameter>(lo[i], async(blob[i].in[4]));
+                adf::connect<parameter>(hi[i], async(blob[i].in[5]));
+
+                source(blob[i]) = "aie_kernels/aie_blobfromimage.cpp";
+                runtime<ratio>(blob[i]) = 0.99;
+            }
+    };
+};
+
+// Streaming variant: the PL sends STREAM_BAND_HEIGHT rows of STREAM_WIDTH
+// pixels per run, the kernel keeps the vertical neighbourhood in a line
+// buffer across runs, so neither overlap rows nor metadata go over PLIO.
+// Output lags the input by one row, a frame takes
+// STREAM_FRAME_HEIGHT / STREAM_BAND_HEIGHT runs.
+class Filter2DStreamGraph : public adf::graph {
     public:
         kernel f2d;
         input_plio in;
         output_plio out;
-        // input_port in;
-        // output_port out;
+        input_port coeff;
+        input_port shift;
 
-        Filter2DGraph() {
+        Filter2DStreamGraph() {
             // create kernel
-            f2d = kernel::create(filter2D);
+            f2d = kernel::create(filter2D_stream);
 
-            in = input_plio::create("DataIn1", plio_128_bits, "data/input.txt");
-            out = output_plio::create("DataOut1", plio_128_bits, "data/output.txt");
+            in = input_plio::create("StreamIn1", plio_128_bits, "data/input_stream.txt");
+            out = output_plio::create("StreamOut1", plio_128_bits, "data/output_stream.txt");
 
             //Make AIE connections
-            adf::connect<window<TILE_WINDOW_SIZE> >(in.out[0], f2d.in[0]);
-            adf::connect<window<TILE_WINDOW_SIZE> >(f2d.out[0], out.in[0]);
-            // connect< window<TILE_WINDOW_SIZE> > net0 (in, f2d.in[0]);
-            // connect< window<TILE_WINDOW_SIZE> > net1 (f2d.out[0], out);
+            adf::connect<stream>(in.out[0], f2d.in[0]);
+            adf::connect<stream>(f2d.out[0], out.in[0]);
+
+            adf::connect<parameter>(coeff, async(f2d.in[1]));
+            adf::connect<parameter>(shift, async(f2d.in[2]));
 
             source(f2d) = "aie_kernels/aie_filter2D.cpp";
             runtime<ratio>(f2d) = 0.99;
@@ -35,4 +646,3 @@ class Filter2DGraph : public adf::graph {
 };
 
 #endif //__GRAPH_H__
-
@@ -0,0 +1,54 @@
+#ifndef _INTEGRAL_IMAGE_H_
+#define _INTEGRAL_IMAGE_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+// Turns the stitched output of IntegralGraph, where every tile holds the
+// summed-area table of its own pixels, into the integral of the image, in
+// place. origins are the {x0, y0} tile origins of the tiler, the
+// xfGetTilePosH / xfGetTilePosV of each tile (xfcvDataMovers::tileOrigins),
+// a tile ends where the next tile origin in its row / column starts. Tiles
+// are processed in raster order, so the tables above and to the left are
+// already global:
+//   S(y, x) = T(y, x) + S(y0 - 1, x) + S(y, x0 - 1) - S(y0 - 1, x0 - 1)
+// for a tile at (y0, x0). Sums wrap at 32 bits on large images, box sums
+// taken as differences of four corners stay exact as long as the box
+// itself fits 32 bits.
+inline void integralCombineTiles(int32_t* sat, int width, int height, const std::vector<std::array<int, 2> >& origins) {
+    std::vector<std::array<int, 2> > tiles = origins;
+    std::sort(tiles.begin(), tiles.end(), [](const std::array<int, 2>& a, const std::array<int, 2>& b) {
+        return std::tie(a[1], a[0]) < std::tie(b[1], b[0]);
+    });
+
+    // Tile edges: every distinct origin plus the image size
+    std::vector<int> edges_x = {width};
+    std::vector<int> edges_y = {height};
+    for (const auto& t : tiles) {
+        edges_x.push_back(t[0]);
+        edges_y.push_back(t[1]);
+    }
+    std::sort(edges_x.begin(), edges_x.end());
+    std::sort(edges_y.begin(), edges_y.end());
+
+    uint32_t* s = (uint32_t*)sat;
+    for (const auto& t : tiles) {
+        const int x0 = t[0];
+        const int y0 = t[1];
+        const int x1 = *std::upper_bound(edges_x.begin(), edges_x.end(), x0);
+        const int y1 = *std::upper_bound(edges_y.begin(), edges_y.end(), y0);
+        const uint32_t corner = (y0 > 0 && x0 > 0) ? s[(y0 - 1) * width + x0 - 1] : 0;
+        for (int y = y0; y < y1; y++) {
+            const uint32_t left = (x0 > 0) ? s[y * width + x0 - 1] - corner : 0;
+            for (int x = x0; x < x1; x++) {
+                const uint32_t top = (y0 > 0) ? s[(y0 - 1) * width + x] : 0;
+                s[y * width + x] += top + left;
+            }
+        }
+    }
+}
+
+#endif //_INTEGRAL_IMAGE_H_
@@ -0,0 +1,102 @@
+#ifndef _RESIZE_PARAMS_H_
+#define _RESIZE_PARAMS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include "config.hpp"
+
+// Runtime parameters of the resize graphs, computed on the host whenever the
+// output resolution changes and pushed with graph.update().
+
+// Scale factor (input / output size) with RESIZE_SCALE_FRAC_BITS fractional
+// bits (kernel RESIZE_SCALE_BITS), e.g. 1920 -> 1280 gives 1.5 * 65536
+static constexpr int RESIZE_SCALE_FRAC_BITS = 16;
+
+inline int resizeScaleQ16(int size_in, int size_out) {
+    return (int)((((int64_t)size_in << RESIZE_SCALE_FRAC_BITS) + size_out / 2) / size_out);
+}
+
+// Source rows per output row of the AREA resize tiler
+// (xfcvDataMoverParams::mResizeRows): the footprint of an output row spans
+// up to ceil(scale_y) + 1 rows. Throws if they or the input width do not
+// fit the kernel window.
+inline int resizeAreaRows(int width_in, int scale_y) {
+    const int rows = ((scale_y + (1 << RESIZE_SCALE_FRAC_BITS) - 1) >> RESIZE_SCALE_FRAC_BITS) + 1;
+    if (rows > RESIZE_AREA_MAX_ROWS_IN) {
+        throw std::runtime_error("Area resize: scale_y needs more than RESIZE_AREA_MAX_ROWS_IN rows");
+    }
+    if (width_in > RESIZE_AREA_MAX_WIDTH_IN) {
+        throw std::runtime_error("Area resize: input wider than RESIZE_AREA_MAX_WIDTH_IN");
+    }
+    return rows;
+}
+
+// Source rows per output row of the BICUBIC resize tiler
+// (xfcvDataMoverParams::mResizeRows): the four rows of the vertical taps.
+// Throws if the input width does not fit the kernel window.
+inline int resizeCubicRows(int width_in) {
+    if (width_in > RESIZE_CUBIC_MAX_WIDTH_IN) {
+        throw std::runtime_error("Bicubic resize: input wider than RESIZE_CUBIC_MAX_WIDTH_IN");
+    }
+    return 4;
+}
+
+// Letterbox geometry of an in_w x in_h frame in a net_w x net_h network input
+// (net_w a multiple of 16, at most RESIZE_MAX_WIDTH_OUT): the aspect
+// preserving content size, with content_w rounded down to a multiple of 16
+// for the planar vector stores, centred in the padding. The resize tiler
+// runs with a content_w x content_h output, which sets the scale and the
+// source rows of each content row; the kernel widens every row to net_w
+// (LETTERBOX_NET_W) and reports that width in the output metadata.
+struct LetterboxGeometry {
+    int net_w;
+    int content_w;
+    int content_h;
+    int pad_left;
+    int pad_top;
+};
+
+inline LetterboxGeometry letterboxGeometry(int in_w, int in_h, int net_w, int net_h) {
+    if (net_w % 16 != 0 || net_w > RESIZE_MAX_WIDTH_OUT) {
+        throw std::runtime_error("Letterbox: net_w must be a multiple of 16 of at most RESIZE_MAX_WIDTH_OUT");
+    }
+    LetterboxGeometry g;
+    g.net_w = net_w;
+    if ((int64_t)in_w * net_h >= (int64_t)in_h * net_w) {
+        g.content_w = net_w;
+        g.content_h = std::max(1, (int)(((int64_t)in_h * net_w + in_w / 2) / in_w));
+    } else {
+        g.content_w = std::max(16, (int)((int64_t)in_w * net_h / in_h) & ~15);
+        g.content_h = net_h;
+    }
+    g.pad_left = ((net_w - g.content_w) / 2) & ~15;
+    g.pad_top = (net_h - g.content_h) / 2;
+    return g;
+}
+
+// Runtime parameters of LetterboxGraph, mean / alpha per R G B channel with
+// alpha in 1/16 (out = (x - mean) * alpha / 16)
+inline void letterboxParams(const LetterboxGeometry& g,
+                            int pad_value,
+                            const int mean[3],
+                            const int alpha[3],
+                            int16_t (&params)[LETTERBOX_PARAMS]) {
+    std::fill(params, params + LETTERBOX_PARAMS, 0);
+    params[LETTERBOX_PAD_LEFT] = g.pad_left;
+    params[LETTERBOX_CONTENT_W] = g.content_w;
+    params[LETTERBOX_PAD_VALUE] = pad_value;
+    params[LETTERBOX_NET_W] = g.net_w;
+    for (int c = 0; c < 3; c++) {
+        params[LETTERBOX_MEAN + c] = mean[c];
+        params[LETTERBOX_ALPHA + c] = alpha[c];
+    }
+}
+
+// Normalized pad value of channel c, for filling the bands above and below
+// the content once per geometry
+inline int8_t letterboxPadValue(int pad_value, int mean, int alpha) {
+    return (int8_t)std::min(127, std::max(-128, ((pad_value - mean) * alpha) >> 4));
+}
+
+#endif //_RESIZE_PARAMS_H_
@@ -0,0 +1,126 @@
+/*
+ * Filter2D data path benchmark
+ *
+ * Measures frame latency and throughput of the filter2D graph for the data
+ * path the binary was built for: PLIO with the PL tiler/stitcher
+ * (FILTER2D_USE_GMIO=0) or GMIO straight from host DDR buffers
+ * (FILTER2D_USE_GMIO=1). Build both and run them on the matching xclbin to
+ * compare.
+ *
+ * Usage: benchmark_<plio|gmio>.exe <xclbin> [width height] [frames]
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <common/xfcvDataMovers.h>
+
+#include "graph.h"
+
+#if FILTER2D_USE_GMIO
+Filter2DGmioGraph<> filter_graph;
+#else
+Filter2DGraph<> filter_graph;
+#endif
+
+#if FILTER2D_8BIT
+static const COEFF_TYPE coeff[FILTER_COEFF_SIZE] = {8, 16, 0, 8, 0, 16, 32, 0, 16, 0, 8, 16, 0, 8, 0, 0};
+#else
+static const COEFF_TYPE coeff[FILTER_COEFF_SIZE] = {64, 128, 0, 64, 0, 128, 256, 0, 128, 0, 64, 128, 0, 64, 0, 0};
+#endif
+static const int shift = FILTER2D_SHIFT;
+
+#if FILTER2D_USE_GMIO
+template <int CORES>
+static std::array<std::string, CORES> portNames(const std::string& prefix) {
+    std::array<std::string, CORES> names;
+    for (int i = 0; i < CORES; i++) names[i] = prefix + "[" + std::to_string(i) + "]";
+    return names;
+}
+#endif
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <xclbin> [width height] [frames]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const char* xclBinName = argv[1];
+    const int width = (argc > 3) ? std::atoi(argv[2]) : 1920;
+    const int height = (argc > 3) ? std::atoi(argv[3]) : 1080;
+    const int frames = (argc > 4) ? std::atoi(argv[4]) : 100;
+
+    const int mat_type = FILTER2D_8BIT ? CV_8UC1 : CV_16SC1;
+    cv::Mat src(height, width, mat_type);
+    cv::randu(src, 0, 256);
+    cv::Mat dst(height, width, mat_type);
+
+    xF::deviceInit(xclBinName);
+
+    filter_graph.init();
+    for (int i = 0; i < NUM_CORES; i++) {
+        filter_graph.update(filter_graph.coeff[i], coeff, FILTER_COEFF_SIZE);
+        filter_graph.update(filter_graph.shift[i], shift);
+    }
+
+#if FILTER2D_USE_GMIO
+    xF::xfcvDataMovers<xF::TILER, DATA_TYPE, TILE_HEIGHT, TILE_WIDTH, VECTORIZATION_FACTOR, NUM_CORES, 0, true> tiler(
+        1, 1);
+    xF::xfcvDataMovers<xF::STITCHER, DATA_TYPE, TILE_HEIGHT, TILE_WIDTH, VECTORIZATION_FACTOR, NUM_CORES, 0, true>
+        stitcher;
+    const auto inPorts = portNames<NUM_CORES>("gmioIn");
+    const auto outPorts = portNames<NUM_CORES>("gmioOut");
+    const char* path = "GMIO";
+#else
+    xF::xfcvDataMovers<xF::TILER, DATA_TYPE, TILE_HEIGHT, TILE_WIDTH, VECTORIZATION_FACTOR, NUM_CORES> tiler(1, 1);
+    xF::xfcvDataMovers<xF::STITCHER, DATA_TYPE, TILE_HEIGHT, TILE_WIDTH, VECTORIZATION_FACTOR, NUM_CORES> stitcher;
+    const char* path = "PLIO";
+#endif
+
+    std::vector<double> latencies;
+    for (int f = 0; f < frames; f++) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+#if FILTER2D_USE_GMIO
+        auto tiles = tiler.host2aie_nb(src, inPorts);
+        stitcher.aie2host_nb(dst, tiles, outPorts);
+        filter_graph.run((tiles[0] * tiles[1]) / NUM_CORES);
+        filter_graph.wait();
+        tiler.wait(inPorts);
+        stitcher.wait(outPorts);
+#else
+        auto tiles = tiler.host2aie_nb(src, nullptr, xF::xfcvDataMoverParams());
+        stitcher.aie2host_nb(dst, tiles);
+        filter_graph.run(tiles[0] * tiles[1]);
+        filter_graph.wait();
+        tiler.wait();
+        stitcher.wait();
+#endif
+
+        auto stop = std::chrono::high_resolution_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+
+    filter_graph.end();
+
+    // First frame includes buffer allocation and metadata generation
+    double total = 0;
+    for (int f = 1; f < frames; f++) total += latencies[f];
+    const int measured = std::max(frames - 1, 1);
+    const double avgLatency = (frames > 1) ? (total / measured) : latencies[0];
+    const double frameBytes = 2.0 * src.total() * src.elemSize(); // in + out
+    const double throughput = (frameBytes / (1024.0 * 1024.0)) / (avgLatency / 1000.0);
+
+    std::cout << path << " " << width << "x" << height << ", " << NUM_CORES << " core(s), " << frames << " frames"
+              << std::endl;
+    std::cout << "  first frame latency : " << latencies[0] << " ms" << std::endl;
+    std::cout << "  avg frame latency   : " << avgLatency << " ms" << std::endl;
+    std::cout << "  throughput          : " << throughput << " MB/s (in + out)" << std::endl;
+    std::cout << "  frame rate          : " << 1000.0 / avgLatency << " fps" << std::endl;
+
+    return EXIT_SUCCESS;
+}